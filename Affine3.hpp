@@ -0,0 +1,187 @@
+#pragma once
+#include <iostream>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+#include "MathUtils.hpp"
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include "Vector.hpp"
+
+// 3D affine transform [L t; 0 0 0 1] stored as its top three rows (3x4, row-major, translation in column 3).
+// The constant bottom row is implicit, so composition costs 36 multiplies instead of the 64 of a 4x4 product and
+// inversion only inverts the 3x3 block. Conventions match Matrix::transform: points are column vectors and
+// (a * b) applies b first, then a. Each row is aligned like a Vector<T, 4> (see TINYMATH_MAX_ALIGNMENT).
+template <typename T>
+class alignas(storage_alignment<T, 4>()) Affine3 {
+    static_assert(std::is_floating_point_v<T>, "Affine3 requires a floating-point element type.");
+
+public:
+    Matrix<T, 3, 4> data{ { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 } };
+
+    // Identity transform
+    constexpr Affine3() = default;
+    constexpr explicit Affine3(const Matrix<T, 3, 4>& rows) : data(rows) {}
+
+    constexpr Affine3(const Matrix<T, 3, 3>& linear, const Vector<T, 3>& translation) {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                data[i][j] = linear[i][j];
+            }
+            data[i][3] = translation[i];
+        }
+    }
+
+    // Drops the bottom row, which must be (0, 0, 0, 1)
+    constexpr explicit Affine3(const Matrix<T, 4, 4>& m) {
+        for (int i = 0; i < 3; ++i) {
+            data[i] = m[i];
+        }
+    }
+
+    // Elementary transforms
+    static constexpr Affine3 translate(const Vector<T, 3>& offset) { return Affine3(Matrix<T, 3, 3>{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }, offset); }
+    static constexpr Affine3 rotate(const Quaternion<T>& rotation) { return Affine3(rotation.to_matrix3(), Vector<T, 3>{}); }
+    // Rotation by angle radians about axis (which must be unit length)
+    static Affine3 rotate(const Vector<T, 3>& axis, T angle) { return rotate(Quaternion<T>::from_axis_angle(axis, angle)); }
+    static constexpr Affine3 scale(const Vector<T, 3>& factors) {
+        return Affine3(Matrix<T, 3, 3>{ { factors[0], 0, 0 }, { 0, factors[1], 0 }, { 0, 0, factors[2] } }, Vector<T, 3>{});
+    }
+    static constexpr Affine3 scale(T factor) { return scale(Vector<T, 3>{ factor, factor, factor }); }
+
+    // Right-handed view transform: eye maps to the origin, looking down -z with up along +y
+    static constexpr Affine3 look_at(const Vector<T, 3>& eye, const Vector<T, 3>& target, const Vector<T, 3>& up) {
+        const Vector<T, 3> f = (target - eye).normalized();
+        const Vector<T, 3> s = f.cross(up).normalized();
+        const Vector<T, 3> u = s.cross(f);
+        return Affine3(Matrix<T, 3, 4>{
+            { s[0], s[1], s[2], -s.dot(eye) },
+            { u[0], u[1], u[2], -u.dot(eye) },
+            { -f[0], -f[1], -f[2], f.dot(eye) }
+        });
+    }
+
+    // Right-handed perspective projection (vertical field of view in radians) mapping view-space depth
+    // [-near, -far] to clip-space z in [-1, 1]. Projections are not affine, so this returns a full 4x4 matrix.
+    static Matrix<T, 4, 4> perspective(T fov_y, T aspect, T near_plane, T far_plane) {
+        assert(aspect != 0 && near_plane != far_plane && "perspective() with a degenerate frustum");
+        const T f = 1 / std::tan(fov_y / 2);
+        const T depth = near_plane - far_plane;
+        Matrix<T, 4, 4> result;
+        result[0][0] = f / aspect;
+        result[1][1] = f;
+        result[2][2] = (far_plane + near_plane) / depth;
+        result[2][3] = 2 * far_plane * near_plane / depth;
+        result[3][2] = -1;
+        return result;
+    }
+
+    constexpr Matrix<T, 3, 3> linear() const {
+        Matrix<T, 3, 3> result;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                result[i][j] = data[i][j];
+            }
+        }
+        return result;
+    }
+    constexpr Vector<T, 3> translation() const { return Vector<T, 3>{ data[0][3], data[1][3], data[2][3] }; }
+
+    constexpr Matrix<T, 4, 4> to_matrix4() const {
+        Matrix<T, 4, 4> result;
+        for (int i = 0; i < 3; ++i) {
+            result[i] = data[i];
+        }
+        result[3][3] = 1;
+        return result;
+    }
+
+    // Composition with an explicit accumulation policy; operator* uses DefaultAccumulation.
+    // Each output row is a combination of the three rows of other, plus this row's translation in column 3.
+    // ExactAccumulation runs the scalar loop; otherwise float (SSE) and double (AVX) use SimdAffineKernel.
+    template <typename Policy = DefaultAccumulation>
+    constexpr Affine3 compose(const Affine3& other) const {
+        Affine3 result;
+        if constexpr (SimdAffineKernel<T>::enabled && !std::is_same_v<Policy, ExactAccumulation>) {
+            if (!std::is_constant_evaluated()) {
+                static_assert(sizeof(Matrix<T, 3, 4>) == 12 * sizeof(T), "Affine3 rows must be tightly packed.");
+                SimdAffineKernel<T>::template compose<Policy>(data[0].data(), other.data[0].data(), result.data[0].data());
+                return result;
+            }
+        }
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                result.data[i][j] = data[i][0] * other.data[0][j];
+            }
+            for (int k = 1; k < 3; ++k) {
+                for (int j = 0; j < 4; ++j) {
+                    result.data[i][j] = multiply_add<Policy>(data[i][k], other.data[k][j], result.data[i][j]);
+                }
+            }
+            result.data[i][3] += data[i][3];
+        }
+        return result;
+    }
+    constexpr Affine3 operator*(const Affine3& other) const { return compose(other); }
+    constexpr Affine3& operator*=(const Affine3& other) { return *this = compose(other); }
+
+    // Points pick up the translation, directions do not
+    template <typename Policy = DefaultAccumulation>
+    constexpr Vector<T, 3> transform_point(const Vector<T, 3>& point) const {
+        Vector<T, 3> result;
+        for (int i = 0; i < 3; ++i) {
+            result[i] = multiply_add<Policy>(data[i][2], point[2], multiply_add<Policy>(data[i][1], point[1], multiply_add<Policy>(data[i][0], point[0], data[i][3])));
+        }
+        return result;
+    }
+
+    template <typename Policy = DefaultAccumulation>
+    constexpr Vector<T, 3> transform_direction(const Vector<T, 3>& direction) const {
+        Vector<T, 3> result;
+        for (int i = 0; i < 3; ++i) {
+            result[i] = dot_product<Policy, 3>(data[i].data(), direction.data.data());
+        }
+        return result;
+    }
+
+    // Inverse as [inv(L) -inv(L)t]; the linear block must not be singular
+    constexpr Affine3 inverse() const { return from_inverse_linear(linear().inverse()); }
+
+    // Inverse of a rigid transform (rotation and translation only): the transposed rotation, no division
+    constexpr Affine3 rigid_inverse() const {
+        Matrix<T, 3, 3> rotation;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                rotation[i][j] = data[j][i];
+            }
+        }
+        return from_inverse_linear(rotation);
+    }
+
+    // Operators
+    constexpr bool operator==(const Affine3& other) const { return data == other.data; }
+    constexpr bool operator!=(const Affine3& other) const { return !(*this == other); }
+    constexpr std::array<T, 4>& operator[](size_t index) { return data[index]; }
+    constexpr const std::array<T, 4>& operator[](size_t index) const { return data[index]; }
+
+    void print() const { to_matrix4().print(); }
+
+private:
+    // Builds [L -L t] from an already inverted linear block L and this transform's translation t
+    constexpr Affine3 from_inverse_linear(const Matrix<T, 3, 3>& inverse_linear) const {
+        Affine3 result;
+        for (int i = 0; i < 3; ++i) {
+            T t = 0;
+            for (int j = 0; j < 3; ++j) {
+                result.data[i][j] = inverse_linear[i][j];
+                t -= inverse_linear[i][j] * data[j][3];
+            }
+            result.data[i][3] = t;
+        }
+        return result;
+    }
+};
+
+// Aliases
+template <typename T> using affine3 = Affine3<T>;
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "Config.hpp"
+
+// Alignment of fixed-size storage holding Count elements of T: the storage size itself when that is a power of two,
+// capped at TINYMATH_MAX_ALIGNMENT, otherwise the natural alignment of T
+template <typename T, std::size_t Count>
+constexpr std::size_t storage_alignment() {
+    constexpr std::size_t bytes = sizeof(T) * Count;
+    constexpr std::size_t limit = TINYMATH_MAX_ALIGNMENT;
+    if constexpr (bytes == 0 || (bytes & (bytes - 1)) != 0 || bytes <= alignof(T) || limit <= alignof(T))
+        return alignof(T);
+    else
+        return bytes < limit ? bytes : limit;
+}
+
+// Standard allocator returning Alignment-byte aligned storage (64 = one cache line / one AVX-512 register)
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two no smaller than alignof(T).");
+
+    using value_type = T;
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+// Contiguous, cache-line aligned growable array
+template <typename T, std::size_t Alignment = 64>
+using AlignedArray = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+// Fixed-size, move-only heap array of value-initialized elements with Alignment-byte aligned storage
+template <typename T, std::size_t Alignment = 64>
+class AlignedBuffer {
+public:
+    AlignedBuffer() = default;
+    explicit AlignedBuffer(std::size_t count) : count(count) {
+        if (count == 0)
+            return;
+        ptr = AlignedAllocator<T, Alignment>().allocate(count);
+        std::uninitialized_value_construct_n(ptr, count);
+    }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+    AlignedBuffer(AlignedBuffer&& other) noexcept : ptr(std::exchange(other.ptr, nullptr)), count(std::exchange(other.count, 0)) {}
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            ptr = std::exchange(other.ptr, nullptr);
+            count = std::exchange(other.count, 0);
+        }
+        return *this;
+    }
+    ~AlignedBuffer() { release(); }
+
+    T* data() { return ptr; }
+    const T* data() const { return ptr; }
+    std::size_t size() const { return count; }
+    T& operator[](std::size_t index) { return ptr[index]; }
+    const T& operator[](std::size_t index) const { return ptr[index]; }
+
+private:
+    void release() {
+        if (ptr) {
+            std::destroy_n(ptr, count);
+            AlignedAllocator<T, Alignment>().deallocate(ptr, count);
+        }
+    }
+
+    T* ptr = nullptr;
+    std::size_t count = 0;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+// Compile-time configuration. Define any of these macros before including MathAPI.hpp to override the defaults.
+
+// SIMD kernels (SSE, optionally AVX) are used when the target supports them.
+// Define TINYMATH_NO_SIMD to force the generic scalar path everywhere.
+#if !defined(TINYMATH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define TINYMATH_SIMD_SSE 1
+#endif
+#if defined(TINYMATH_SIMD_SSE) && defined(__AVX__)
+    #define TINYMATH_SIMD_AVX 1
+#endif
+
+// Hardware fused multiply-add. Without it FusedAccumulation keeps its independent partial sums but uses a
+// separate multiply and add, since a software std::fma would be far slower than the unfused pair.
+#if !defined(TINYMATH_NO_SIMD) && (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+    #define TINYMATH_FMA 1
+#endif
+
+// Define TINYMATH_LEGACY_ACCUMULATION to make ExactAccumulation (sequential multiply then add, bit-identical to
+// the original loops) the default policy for dot, Matrix::transform and Matrix::multiply instead of
+// FusedAccumulation. Bit-exactness also requires the compiler not to contract a * b + c on its own
+// (e.g. -ffp-contract=off).
+
+// Define TINYMATH_INSTRUMENT to count calls, estimated floating-point operations and wall time per operation in
+// thread-local counters (see Instrumentation.hpp). Each instrumented call then reads the clock twice; without the
+// macro the hooks compile to nothing.
+
+// Vector and Matrix types whose storage is a power-of-two number of bytes are aligned to that size, capped at this
+// value (16 = one SSE register, 32 = one AVX register, 64 = one cache line), so a Vector<float, 4> or a float 4x4
+// matrix never straddles a cache line. Sizes do not change, so arrays of them stay tightly packed; containers of
+// over-aligned types get aligned storage from the standard allocator (C++17 aligned new) or AlignedAllocator.
+// Define as 0 to keep the natural alignment of the element type.
+#ifndef TINYMATH_MAX_ALIGNMENT
+    #define TINYMATH_MAX_ALIGNMENT 64
+#endif
+
+// Matrix::multiply switches from the naive triple loop to the cache-blocked GEMM kernel
+// once every dimension of the product reaches this size.
+#ifndef TINYMATH_GEMM_BLOCKED_MIN_DIM
+    #define TINYMATH_GEMM_BLOCKED_MIN_DIM 24
+#endif
+
+// distance_matrix computes a.b with the blocked GEMM, instead of summing squared differences directly, for points of
+// at least this many components. Below it, the register-blocked direct kernel is faster, despite its extra subtraction.
+#ifndef TINYMATH_DISTANCE_GEMM_MIN_DIM
+    #define TINYMATH_DISTANCE_GEMM_MIN_DIM 128
+#endif
+
+// Matrix and DynMatrix transposes switch from the plain double loop to the cache-oblivious blocked kernel
+// (Transpose.hpp) once both dimensions reach this size.
+#ifndef TINYMATH_TRANSPOSE_BLOCKED_MIN_DIM
+    #define TINYMATH_TRANSPOSE_BLOCKED_MIN_DIM 16
+#endif
+
+// Vector::normalize_batch and scale_batch write outputs of at least this many bytes with non-temporal stores that
+// bypass the cache (see Streaming.hpp). Keep it above the last-level cache size: below it, results that stay cached
+// for the caller's next pass are worth more than the saved bandwidth.
+#ifndef TINYMATH_STREAMING_MIN_BYTES
+    #define TINYMATH_STREAMING_MIN_BYTES (32 << 20)
+#endif
+
+// Batch kernels only split work across threads when every thread gets at least this many elements.
+#ifndef TINYMATH_PARALLEL_MIN_BATCH
+    #define TINYMATH_PARALLEL_MIN_BATCH (1 << 16)
+#endif
+
+// PointIndex batch queries only split across threads when every thread gets at least this many queries.
+#ifndef TINYMATH_PARALLEL_MIN_QUERIES
+    #define TINYMATH_PARALLEL_MIN_QUERIES 64
+#endif
+
+// Total thread count of the library-owned ThreadPool (0 = one per hardware thread).
+// ThreadPool::set_thread_count and ThreadPool::set_current change it at run time.
+#ifndef TINYMATH_NUM_THREADS
+    #define TINYMATH_NUM_THREADS 0
+#endif
+
+// GEMM products below this many floating-point operations (2 * M * N * K) always run on the calling thread.
+#ifndef TINYMATH_PARALLEL_GEMM_MIN_FLOPS
+    #define TINYMATH_PARALLEL_GEMM_MIN_FLOPS (2.0 * 128 * 128 * 128)
+#endif
@@ -0,0 +1,490 @@
+#pragma once
+#include <array>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include "Config.hpp"
+#include "Matrix.hpp"
+#include "MathUtils.hpp"
+#include "Parallel.hpp"
+#include "Vector.hpp"
+#include "VectorBatch.hpp"
+
+// Factorizations of fixed-size matrices, created with Matrix::lu(), Matrix::qr() and Matrix::cholesky().
+// Each object keeps its factors in fixed-size storage next to the object (no heap allocation), and every solve has
+// a solve_in_place variant that overwrites the right-hand side. All of them are usable in constant expressions.
+
+// Partial-pivoting LU: P * A = L * U, with L (unit diagonal) and U packed into one matrix
+template <typename T, int N>
+class LU {
+public:
+    constexpr explicit LU(const Matrix<T, N, N>& m) : factors(m) {
+        for (int i = 0; i < N; ++i)
+            perm[i] = i;
+        for (int k = 0; k < N; ++k) {
+            int pivot = k;
+            for (int r = k + 1; r < N; ++r) {
+                if (math_abs(factors[r][k]) > math_abs(factors[pivot][k]))
+                    pivot = r;
+            }
+            if (pivot != k) {
+                std::swap(factors[k], factors[pivot]);
+                std::swap(perm[k], perm[pivot]);
+                sign = -sign;
+            }
+            if (factors[k][k] == T(0)) {
+                singular = true;
+                continue;
+            }
+            for (int r = k + 1; r < N; ++r) {
+                const T f = factors[r][k] / factors[k][k];
+                factors[r][k] = f;
+                for (int j = k + 1; j < N; ++j)
+                    factors[r][j] -= f * factors[k][j];
+            }
+        }
+    }
+
+    // False when a zero pivot was met; solve() and inverse() require an invertible matrix
+    constexpr bool invertible() const { return !singular; }
+
+    constexpr Vector<T, N> solve(const Vector<T, N>& b) const {
+        Vector<T, N> x = b;
+        solve_in_place(x);
+        return x;
+    }
+
+    constexpr void solve_in_place(Vector<T, N>& b) const {
+        assert(invertible() && "LU::solve on a singular matrix");
+        Vector<T, N> y;
+        for (int i = 0; i < N; ++i) {
+            T sum = b[perm[i]];
+            for (int j = 0; j < i; ++j)
+                sum -= factors[i][j] * y[j];
+            y[i] = sum;
+        }
+        for (int i = N - 1; i >= 0; --i) {
+            T sum = y[i];
+            for (int j = i + 1; j < N; ++j)
+                sum -= factors[i][j] * y[j];
+            y[i] = sum / factors[i][i];
+        }
+        b = y;
+    }
+
+    // Multiple right-hand sides, one per column of b
+    template <int K>
+    constexpr Matrix<T, N, K> solve(const Matrix<T, N, K>& b) const {
+        Matrix<T, N, K> x = b;
+        solve_in_place(x);
+        return x;
+    }
+
+    template <int K>
+    constexpr void solve_in_place(Matrix<T, N, K>& b) const {
+        assert(invertible() && "LU::solve on a singular matrix");
+        Matrix<T, N, K> y;
+        for (int i = 0; i < N; ++i) {
+            y[i] = b[perm[i]];
+            for (int j = 0; j < i; ++j)
+                for (int c = 0; c < K; ++c)
+                    y[i][c] -= factors[i][j] * y[j][c];
+        }
+        for (int i = N - 1; i >= 0; --i) {
+            for (int j = i + 1; j < N; ++j)
+                for (int c = 0; c < K; ++c)
+                    y[i][c] -= factors[i][j] * y[j][c];
+            for (int c = 0; c < K; ++c)
+                y[i][c] /= factors[i][i];
+        }
+        b = y;
+    }
+
+    constexpr T determinant() const {
+        T det = sign;
+        for (int i = 0; i < N; ++i)
+            det *= factors[i][i];
+        return det;
+    }
+
+    constexpr Matrix<T, N, N> inverse() const {
+        Matrix<T, N, N> identity;
+        for (int i = 0; i < N; ++i)
+            identity[i][i] = 1;
+        return solve(identity);
+    }
+
+    // L strictly below the diagonal (unit diagonal implied), U on and above it
+    constexpr const Matrix<T, N, N>& packed() const { return factors; }
+    // Row i of P * A is row permutation()[i] of A
+    constexpr const std::array<int, N>& permutation() const { return perm; }
+
+private:
+    Matrix<T, N, N> factors;
+    std::array<int, N> perm{};
+    int sign = 1;
+    bool singular = false;
+};
+
+// Householder QR of a Rows x Cols matrix (Rows >= Cols): A = Q * R. solve() returns the least-squares solution.
+template <typename T, int Rows, int Cols>
+class QR {
+    static_assert(Rows >= Cols, "QR requires at least as many rows as columns.");
+
+public:
+    constexpr explicit QR(const Matrix<T, Rows, Cols>& m) : factors(m) {
+        for (int k = 0; k < Cols; ++k) {
+            // Reflector H = I - tau * v * v^T with v[k] = 1 maps column k below the diagonal to (beta, 0, ..., 0)
+            const T alpha = factors[k][k];
+            T tail = 0;
+            for (int i = k + 1; i < Rows; ++i)
+                tail += factors[i][k] * factors[i][k];
+            if (tail == T(0)) {
+                tau[k] = 0;
+                if (alpha == T(0))
+                    deficient = true;
+                continue;
+            }
+            const T norm = math_sqrt(alpha * alpha + tail);
+            const T beta = alpha >= 0 ? -norm : norm;
+            tau[k] = (beta - alpha) / beta;
+            const T scale = 1 / (alpha - beta);
+            for (int i = k + 1; i < Rows; ++i)
+                factors[i][k] *= scale;
+            factors[k][k] = beta;
+            for (int j = k + 1; j < Cols; ++j) {
+                T w = factors[k][j];
+                for (int i = k + 1; i < Rows; ++i)
+                    w += factors[i][k] * factors[i][j];
+                w *= tau[k];
+                factors[k][j] -= w;
+                for (int i = k + 1; i < Rows; ++i)
+                    factors[i][j] -= w * factors[i][k];
+            }
+        }
+    }
+
+    // False when R has a zero on its diagonal; solve() requires full column rank
+    constexpr bool full_rank() const { return !deficient; }
+
+    constexpr Vector<T, Cols> solve(const Vector<T, Rows>& b) const {
+        Vector<T, Rows> y = b;
+        solve_in_place(y);
+        Vector<T, Cols> x;
+        std::copy_n(y.data.begin(), Cols, x.data.begin());
+        return x;
+    }
+
+    // Overwrites b with Q^T * b and its first Cols entries with the solution
+    constexpr void solve_in_place(Vector<T, Rows>& b) const {
+        assert(full_rank() && "QR::solve on a rank-deficient matrix");
+        for (int k = 0; k < Cols; ++k) {
+            T w = b[k];
+            for (int i = k + 1; i < Rows; ++i)
+                w += factors[i][k] * b[i];
+            w *= tau[k];
+            b[k] -= w;
+            for (int i = k + 1; i < Rows; ++i)
+                b[i] -= w * factors[i][k];
+        }
+        for (int i = Cols - 1; i >= 0; --i) {
+            T sum = b[i];
+            for (int j = i + 1; j < Cols; ++j)
+                sum -= factors[i][j] * b[j];
+            b[i] = sum / factors[i][i];
+        }
+    }
+
+    // Multiple right-hand sides, one per column of b
+    template <int K>
+    constexpr Matrix<T, Cols, K> solve(const Matrix<T, Rows, K>& b) const {
+        Matrix<T, Rows, K> y = b;
+        solve_in_place(y);
+        Matrix<T, Cols, K> x;
+        std::copy_n(y.data.begin(), Cols, x.data.begin());
+        return x;
+    }
+
+    template <int K>
+    constexpr void solve_in_place(Matrix<T, Rows, K>& b) const {
+        assert(full_rank() && "QR::solve on a rank-deficient matrix");
+        for (int k = 0; k < Cols; ++k) {
+            for (int c = 0; c < K; ++c) {
+                T w = b[k][c];
+                for (int i = k + 1; i < Rows; ++i)
+                    w += factors[i][k] * b[i][c];
+                w *= tau[k];
+                b[k][c] -= w;
+                for (int i = k + 1; i < Rows; ++i)
+                    b[i][c] -= w * factors[i][k];
+            }
+        }
+        for (int i = Cols - 1; i >= 0; --i) {
+            for (int j = i + 1; j < Cols; ++j)
+                for (int c = 0; c < K; ++c)
+                    b[i][c] -= factors[i][j] * b[j][c];
+            for (int c = 0; c < K; ++c)
+                b[i][c] /= factors[i][i];
+        }
+    }
+
+    // Upper-triangular Cols x Cols factor
+    constexpr Matrix<T, Cols, Cols> r() const {
+        Matrix<T, Cols, Cols> result;
+        for (int i = 0; i < Cols; ++i)
+            for (int j = i; j < Cols; ++j)
+                result[i][j] = factors[i][j];
+        return result;
+    }
+
+    // Thin Rows x Cols factor with orthonormal columns, built by applying the reflectors to the identity
+    constexpr Matrix<T, Rows, Cols> q() const {
+        Matrix<T, Rows, Cols> result;
+        for (int j = 0; j < Cols; ++j)
+            result[j][j] = 1;
+        for (int k = Cols - 1; k >= 0; --k) {
+            for (int j = 0; j < Cols; ++j) {
+                T w = result[k][j];
+                for (int i = k + 1; i < Rows; ++i)
+                    w += factors[i][k] * result[i][j];
+                w *= tau[k];
+                result[k][j] -= w;
+                for (int i = k + 1; i < Rows; ++i)
+                    result[i][j] -= w * factors[i][k];
+            }
+        }
+        return result;
+    }
+
+private:
+    Matrix<T, Rows, Cols> factors;
+    std::array<T, Cols> tau{};
+    bool deficient = false;
+};
+
+// Cholesky factorization of a symmetric positive-definite matrix: A = L * L^T. Only the lower triangle of A is read.
+template <typename T, int N>
+class Cholesky {
+public:
+    constexpr explicit Cholesky(const Matrix<T, N, N>& m) {
+        for (int j = 0; j < N; ++j) {
+            T d = m[j][j];
+            for (int k = 0; k < j; ++k)
+                d -= factor[j][k] * factor[j][k];
+            if (!(d > T(0))) {
+                definite = false;
+                return;
+            }
+            const T l = math_sqrt(d);
+            factor[j][j] = l;
+            for (int i = j + 1; i < N; ++i) {
+                T sum = m[i][j];
+                for (int k = 0; k < j; ++k)
+                    sum -= factor[i][k] * factor[j][k];
+                factor[i][j] = sum / l;
+            }
+        }
+    }
+
+    // False when the matrix is not (numerically) positive definite; solve() requires a definite matrix
+    constexpr bool positive_definite() const { return definite; }
+
+    constexpr Vector<T, N> solve(const Vector<T, N>& b) const {
+        Vector<T, N> x = b;
+        solve_in_place(x);
+        return x;
+    }
+
+    constexpr void solve_in_place(Vector<T, N>& b) const {
+        assert(positive_definite() && "Cholesky::solve on a matrix that is not positive definite");
+        for (int i = 0; i < N; ++i) {
+            T sum = b[i];
+            for (int k = 0; k < i; ++k)
+                sum -= factor[i][k] * b[k];
+            b[i] = sum / factor[i][i];
+        }
+        for (int i = N - 1; i >= 0; --i) {
+            T sum = b[i];
+            for (int k = i + 1; k < N; ++k)
+                sum -= factor[k][i] * b[k];
+            b[i] = sum / factor[i][i];
+        }
+    }
+
+    // Multiple right-hand sides, one per column of b
+    template <int K>
+    constexpr Matrix<T, N, K> solve(const Matrix<T, N, K>& b) const {
+        Matrix<T, N, K> x = b;
+        solve_in_place(x);
+        return x;
+    }
+
+    template <int K>
+    constexpr void solve_in_place(Matrix<T, N, K>& b) const {
+        assert(positive_definite() && "Cholesky::solve on a matrix that is not positive definite");
+        for (int i = 0; i < N; ++i) {
+            for (int k = 0; k < i; ++k)
+                for (int c = 0; c < K; ++c)
+                    b[i][c] -= factor[i][k] * b[k][c];
+            for (int c = 0; c < K; ++c)
+                b[i][c] /= factor[i][i];
+        }
+        for (int i = N - 1; i >= 0; --i) {
+            for (int k = i + 1; k < N; ++k)
+                for (int c = 0; c < K; ++c)
+                    b[i][c] -= factor[k][i] * b[k][c];
+            for (int c = 0; c < K; ++c)
+                b[i][c] /= factor[i][i];
+        }
+    }
+
+    constexpr T determinant() const {
+        T det = 1;
+        for (int i = 0; i < N; ++i)
+            det *= factor[i][i] * factor[i][i];
+        return det;
+    }
+
+    // Lower-triangular factor
+    constexpr const Matrix<T, N, N>& l() const { return factor; }
+
+private:
+    Matrix<T, N, N> factor;
+    bool definite = true;
+};
+
+template <typename T, int Rows, int Cols> class MatrixBatch;
+
+// Batched solvers (include MatrixBatch.hpp): one small system per batch index, factored and solved in place.
+// Each step of the algorithm is a loop over the systems of a block, so the compiler vectorizes across systems;
+// large batches are split across threads unless allow_threads is false. a is overwritten as workspace and b holds the
+// solutions on return. Systems that are singular (LU) or not positive definite (Cholesky) produce non-finite solutions.
+
+// Systems per block of the batched solvers: the block's workspace stays around 16 KB so it lives in L1
+template <typename T, int N>
+inline constexpr size_t SolveBatchBlock = std::max<size_t>(8, (16384 / (sizeof(T) * N * (N + 1))) & ~size_t(7));
+
+// Copies blocks of systems into local workspace arrays (which the compiler knows do not alias), runs
+// kernel(A, B, count) on them with A[i][j][s] and B[i][s] holding system s, and writes the results back
+template <typename T, int N, typename F>
+void solve_batch_blocks(MatrixBatch<T, N, N>& a, VectorBatch<T, N>& b, bool allow_threads, F kernel) {
+    assert(a.size() == b.size());
+    constexpr size_t Block = SolveBatchBlock<T, N>;
+    auto body = [&](size_t begin, size_t end) {
+        alignas(64) T A[N][N][Block];
+        alignas(64) T B[N][Block];
+        for (size_t base = begin; base < end; base += Block) {
+            const size_t count = std::min(Block, end - base);
+            for (int i = 0; i < N; ++i) {
+                for (int j = 0; j < N; ++j)
+                    std::copy_n(a.lane(i, j) + base, count, A[i][j]);
+                std::copy_n(b.lane(i) + base, count, B[i]);
+            }
+            kernel(A, B, count);
+            for (int i = 0; i < N; ++i) {
+                for (int j = 0; j < N; ++j)
+                    std::copy_n(A[i][j], count, a.lane(i, j) + base);
+                std::copy_n(B[i], count, b.lane(i) + base);
+            }
+        }
+    };
+    if (allow_threads)
+        parallel_for(a.size(), TINYMATH_PARALLEL_MIN_BATCH, body);
+    else
+        body(0, a.size());
+}
+
+// Exchanges x[s] and y[s] wherever mask[s] is 1
+template <typename T>
+void conditional_swap(T* x, T* y, const T* mask, size_t count) {
+    for (size_t s = 0; s < count; ++s) {
+        const T a = x[s], b = y[s];
+        x[s] = mask[s] != 0 ? b : a;
+        y[s] = mask[s] != 0 ? a : b;
+    }
+}
+
+// Solves U * x = B per system with U the upper triangle of A, overwriting B
+template <typename T, int N, size_t Block>
+void back_substitute_batch(T (&A)[N][N][Block], T (&B)[N][Block], size_t count) {
+    for (int i = N - 1; i >= 0; --i) {
+        for (int j = i + 1; j < N; ++j) {
+            for (size_t s = 0; s < count; ++s)
+                B[i][s] -= A[i][j][s] * B[j][s];
+        }
+        for (size_t s = 0; s < count; ++s)
+            B[i][s] /= A[i][i][s];
+    }
+}
+
+// Gaussian elimination with partial pivoting per system. Pivot rows are chosen with a branch-free compare-and-swap
+// per candidate row, so every system runs the same instruction stream.
+template <typename T, int N>
+void lu_solve_batch(MatrixBatch<T, N, N>& a, VectorBatch<T, N>& b, bool allow_threads = true) {
+    constexpr size_t Block = SolveBatchBlock<T, N>;
+    solve_batch_blocks(a, b, allow_threads, [](T (&A)[N][N][Block], T (&B)[N][Block], size_t count) {
+        alignas(64) T f[Block];
+        for (int k = 0; k < N; ++k) {
+            for (int r = k + 1; r < N; ++r) {
+                // f[s] = 1 where row r has the larger pivot candidate; the rows are then exchanged with selects
+                for (size_t s = 0; s < count; ++s)
+                    f[s] = math_abs(A[r][k][s]) > math_abs(A[k][k][s]) ? T(1) : T(0);
+                for (int j = 0; j < N; ++j)
+                    conditional_swap(A[k][j], A[r][j], f, count);
+                conditional_swap(B[k], B[r], f, count);
+            }
+            for (int r = k + 1; r < N; ++r) {
+                for (size_t s = 0; s < count; ++s) {
+                    f[s] = A[r][k][s] / A[k][k][s];
+                    A[r][k][s] = f[s];
+                    B[r][s] -= f[s] * B[k][s];
+                }
+                for (int j = k + 1; j < N; ++j) {
+                    for (size_t s = 0; s < count; ++s)
+                        A[r][j][s] -= f[s] * A[k][j][s];
+                }
+            }
+        }
+        back_substitute_batch<T, N, Block>(A, B, count);
+    });
+}
+
+// Cholesky factorization and two triangular solves per system; only the lower triangle of each matrix is read
+template <typename T, int N>
+void cholesky_solve_batch(MatrixBatch<T, N, N>& a, VectorBatch<T, N>& b, bool allow_threads = true) {
+    constexpr size_t Block = SolveBatchBlock<T, N>;
+    solve_batch_blocks(a, b, allow_threads, [](T (&A)[N][N][Block], T (&B)[N][Block], size_t count) {
+        alignas(64) T inv[Block];
+        for (int j = 0; j < N; ++j) {
+            for (int k = 0; k < j; ++k) {
+                for (size_t s = 0; s < count; ++s)
+                    A[j][j][s] -= A[j][k][s] * A[j][k][s];
+            }
+            for (size_t s = 0; s < count; ++s) {
+                A[j][j][s] = std::sqrt(A[j][j][s]);
+                inv[s] = 1 / A[j][j][s];
+            }
+            for (int i = j + 1; i < N; ++i) {
+                for (int k = 0; k < j; ++k) {
+                    for (size_t s = 0; s < count; ++s)
+                        A[i][j][s] -= A[i][k][s] * A[j][k][s];
+                }
+                for (size_t s = 0; s < count; ++s)
+                    A[i][j][s] *= inv[s];
+            }
+        }
+        // Forward substitution with L, then mirror L into the upper triangle so the back substitution solves L^T
+        for (int i = 0; i < N; ++i) {
+            for (int k = 0; k < i; ++k) {
+                for (size_t s = 0; s < count; ++s)
+                    B[i][s] -= A[i][k][s] * B[k][s];
+            }
+            for (size_t s = 0; s < count; ++s)
+                B[i][s] /= A[i][i][s];
+            for (int k = 0; k < i; ++k)
+                std::copy_n(A[i][k], count, A[k][i]);
+        }
+        back_substitute_batch<T, N, Block>(A, B, count);
+    });
+}
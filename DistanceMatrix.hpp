@@ -0,0 +1,176 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "AlignedAllocator.hpp"
+#include "Config.hpp"
+#include "DynMatrix.hpp"
+#include "Gemm.hpp"
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
+
+// All-pairs distances between two sets of points: out(i, j) is the distance from a[i] to b[j].
+// The output is cut into DistanceTileRows x DistanceTileCols tiles that the current ThreadPool computes
+// concurrently. Each tile is either expanded as ||a||^2 + ||b||^2 - 2 a.b, with the a.b products from the blocked
+// GEMM and the norms added while the tile is still in cache, or, for points of fewer than
+// TINYMATH_DISTANCE_GEMM_MIN_DIM components, summed directly over the differences. The GEMM form cancels when two
+// points are close together but far from the origin, so both sets are first shifted to their common centroid; its
+// squared distances then carry an absolute error of a few ULP of the larger squared norm about that centroid, and are
+// clamped at zero.
+
+constexpr int DistanceTileRows = 96;
+constexpr int DistanceTileCols = 256;
+
+// Centered copy of points as a count x N row-major array, and the squared norm of every row
+template <typename T, int N>
+void distance_prepare(std::span<const Vector<T, N>> points, const Vector<T, N>& center, T* centered, T* norms) {
+    for (size_t i = 0; i < points.size(); ++i) {
+        T norm = 0;
+        for (int c = 0; c < N; ++c) {
+            const T x = points[i][c] - center[c];
+            centered[i * N + c] = x;
+            norm += x * x;
+        }
+        norms[i] = norm;
+    }
+}
+
+// Direct kernel strip: the outputs of one row that fill a vector register, summed there across all N components
+#ifdef TINYMATH_SIMD_AVX
+template <typename T>
+constexpr int DistanceStrip = 32 / sizeof(T);
+#else
+template <typename T>
+constexpr int DistanceStrip = 16 / sizeof(T);
+#endif
+
+// Stores count <= DistanceStrip sums of squares from a strip, square rooted for Root. Whole strips take a fixed-length
+// loop and, for Root, the vector square root, since std::sqrt keeps its scalar errno path.
+template <bool Root, typename T>
+void distance_store(T* out, const T* sums, int count) {
+    constexpr int S = DistanceStrip<T>;
+    if (count == S) {
+        if constexpr (Root && SimdKernel<T, 4>::enabled && S % 4 == 0) {
+            using K = SimdKernel<T, 4>;
+            for (int s = 0; s < S; s += 4)
+                K::store(out + s, K::sqrt(K::load(sums + s)));
+        } else {
+            for (int s = 0; s < S; ++s)
+                out[s] = Root ? std::sqrt(sums[s]) : sums[s];
+        }
+    } else {
+        for (int s = 0; s < count; ++s)
+            out[s] = Root ? std::sqrt(sums[s]) : sums[s];
+    }
+}
+
+// Direct kernel body: rows of a against the transposed, zero-padded lanes of b
+template <bool Root, typename T, int N>
+void distance_rows(int rows, int cols, int padded, const T* a, const T* lanes, T* out, std::ptrdiff_t stride) {
+    constexpr int S = DistanceStrip<T>;
+    // Rows go in pairs that share every load from lanes; an odd last row is paired with itself
+    for (int i = 0; i < rows; i += 2) {
+        const T* a0 = a + i * N;
+        const T* a1 = a + std::min(i + 1, rows - 1) * N;
+        for (int j = 0; j < padded; j += S) {
+            T acc0[S] = {}, acc1[S] = {};
+            for (int c = 0; c < N; ++c) {
+                const T x0 = a0[c], x1 = a1[c];
+                const T* lane = lanes + c * DistanceTileCols + j;
+                for (int s = 0; s < S; ++s) {
+                    const T d0 = x0 - lane[s];
+                    const T d1 = x1 - lane[s];
+                    acc0[s] += d0 * d0;
+                    acc1[s] += d1 * d1;
+                }
+            }
+            const int count = std::min(S, cols - j);
+            distance_store<Root>(out + i * stride + j, acc0, count);
+            if (i + 1 < rows)
+                distance_store<Root>(out + (i + 1) * stride + j, acc1, count);
+        }
+    }
+}
+
+// One tile: rows x cols output elements for a[0, rows) against b[0, cols), both centered, with row stride stride
+template <bool Root, typename T, int N>
+void distance_tile(int rows, int cols, const T* a, [[maybe_unused]] const T* a_norms, const T* b,
+    [[maybe_unused]] const T* b_norms, T* out, std::ptrdiff_t stride) {
+    if constexpr (N >= TINYMATH_DISTANCE_GEMM_MIN_DIM) {
+        gemm_serial(rows, cols, N, a, N, 1, b, 1, N, out, stride, 1);
+        for (int i = 0; i < rows; ++i) {
+            T* row = out + i * stride;
+            for (int j = 0; j < cols; ++j) {
+                const T squared = std::max(a_norms[i] + b_norms[j] - 2 * row[j], T(0));
+                row[j] = Root ? std::sqrt(squared) : squared;
+            }
+        }
+    } else {
+        // b transposed into lanes of DistanceTileCols, zero-padded to whole strips. Each strip of DistanceStrip outputs
+        // in a row is summed over all N components in locals, which stay in registers, and stored once.
+        constexpr int S = DistanceStrip<T>;
+        thread_local std::vector<T> lanes;
+        lanes.resize(N * DistanceTileCols);
+        for (int j = 0; j < cols; ++j) {
+            for (int c = 0; c < N; ++c)
+                lanes[c * DistanceTileCols + j] = b[j * N + c];
+        }
+        const int padded = (cols + S - 1) / S * S;
+        for (int c = 0; c < N; ++c)
+            std::fill(lanes.begin() + c * DistanceTileCols + cols, lanes.begin() + c * DistanceTileCols + padded, T(0));
+        distance_rows<Root, T, N>(rows, cols, padded, a, lanes.data(), out, stride);
+    }
+}
+
+template <bool Root, typename T, int N>
+void distance_matrix_into(std::span<const Vector<T, N>> a, std::span<const Vector<T, N>> b, MatrixView<T> out, bool allow_threads) {
+    assert(out.rows == static_cast<int>(a.size()) && out.cols == static_cast<int>(b.size()) && out.col_stride == 1);
+    const int m = out.rows;
+    const int n = out.cols;
+    if (m == 0 || n == 0)
+        return;
+
+    Vector<T, N> center = Vector<T, N>::sum(a, allow_threads) + Vector<T, N>::sum(b, allow_threads);
+    center /= static_cast<T>(a.size() + b.size());
+    AlignedArray<T> a_centered(a.size() * N), b_centered(b.size() * N), a_norms(a.size()), b_norms(b.size());
+    distance_prepare(a, center, a_centered.data(), a_norms.data());
+    distance_prepare(b, center, b_centered.data(), b_norms.data());
+
+    const int tiles_m = (m + DistanceTileRows - 1) / DistanceTileRows;
+    const int tiles_n = (n + DistanceTileCols - 1) / DistanceTileCols;
+    auto tile = [&](size_t t) {
+        const int i = static_cast<int>(t / tiles_n) * DistanceTileRows;
+        const int j = static_cast<int>(t % tiles_n) * DistanceTileCols;
+        distance_tile<Root, T, N>(std::min(DistanceTileRows, m - i), std::min(DistanceTileCols, n - j),
+            a_centered.data() + i * N, a_norms.data() + i, b_centered.data() + j * N, b_norms.data() + j,
+            out.data + i * out.row_stride + j, out.row_stride);
+    };
+    const size_t tiles = static_cast<size_t>(tiles_m) * tiles_n;
+    ThreadPool& pool = ThreadPool::current();
+    if (allow_threads && tiles > 1 && pool.size() > 1 && 3.0 * m * n * N >= TINYMATH_PARALLEL_GEMM_MIN_FLOPS) {
+        pool.run(tiles, tile);
+    } else {
+        for (size_t t = 0; t < tiles; ++t)
+            tile(t);
+    }
+}
+
+// a.size() x b.size() matrix of Vector::distance(a[i], b[j]), split across threads for large sets unless
+// allow_threads is false
+template <typename T, int N>
+DynMatrix<T> distance_matrix(std::span<const Vector<T, N>> a, std::span<const Vector<T, N>> b, bool allow_threads = true) {
+    DynMatrix<T> result(static_cast<int>(a.size()), static_cast<int>(b.size()));
+    distance_matrix_into<true>(a, b, result.view(), allow_threads);
+    return result;
+}
+
+// The same with Vector::distance_squared, skipping the square roots
+template <typename T, int N>
+DynMatrix<T> distance_squared_matrix(std::span<const Vector<T, N>> a, std::span<const Vector<T, N>> b, bool allow_threads = true) {
+    DynMatrix<T> result(static_cast<int>(a.size()), static_cast<int>(b.size()));
+    distance_matrix_into<false>(a, b, result.view(), allow_threads);
+    return result;
+}
@@ -0,0 +1,293 @@
+#pragma once
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "AlignedAllocator.hpp"
+#include "Config.hpp"
+#include "DynVector.hpp"
+#include "Gemm.hpp"
+#include "Instrumentation.hpp"
+#include "Matrix.hpp"
+#include "Simd.hpp"
+#include "Transpose.hpp"
+
+// Non-owning strided view of a dense matrix; element (i, j) lives at data[i * row_stride + j * col_stride].
+// Views wrap both fixed-size Matrix and DynMatrix storage, so kernels written against views run on either.
+template <typename T>
+struct MatrixView {
+    T* data = nullptr;
+    int rows = 0;
+    int cols = 0;
+    std::ptrdiff_t row_stride = 0;
+    std::ptrdiff_t col_stride = 1;
+
+    MatrixView() = default;
+    MatrixView(T* data, int rows, int cols, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride = 1)
+        : data(data), rows(rows), cols(cols), row_stride(row_stride), col_stride(col_stride) {}
+
+    template <int R, int C>
+    MatrixView(Matrix<std::remove_const_t<T>, R, C>& m) : MatrixView(m.data[0].data(), R, C, C) {}
+    template <int R, int C> requires std::is_const_v<T>
+    MatrixView(const Matrix<std::remove_const_t<T>, R, C>& m) : MatrixView(m.data[0].data(), R, C, C) {}
+    template <typename U> requires (std::is_const_v<T> && std::is_same_v<const U, T>)
+    MatrixView(const MatrixView<U>& other) : MatrixView(other.data, other.rows, other.cols, other.row_stride, other.col_stride) {}
+
+    T& operator()(int i, int j) const { return data[i * row_stride + j * col_stride]; }
+
+    // Transposed view of the same storage
+    MatrixView transposed() const { return MatrixView(data, cols, rows, col_stride, row_stride); }
+};
+
+// c = a * b on views, using the blocked GEMM for large operands
+template <typename T>
+void multiply_into(MatrixView<const T> a, MatrixView<const T> b, MatrixView<T> c) {
+    assert(a.cols == b.rows && c.rows == a.rows && c.cols == b.cols);
+    if (a.rows >= TINYMATH_GEMM_BLOCKED_MIN_DIM && a.cols >= TINYMATH_GEMM_BLOCKED_MIN_DIM && b.cols >= TINYMATH_GEMM_BLOCKED_MIN_DIM) {
+        gemm(a.rows, b.cols, a.cols, a.data, a.row_stride, a.col_stride, b.data, b.row_stride, b.col_stride,
+             c.data, c.row_stride, c.col_stride);
+        return;
+    }
+    for (int i = 0; i < a.rows; ++i) {
+        for (int j = 0; j < b.cols; ++j) {
+            T sum = 0;
+            for (int k = 0; k < a.cols; ++k) {
+                sum += a(i, k) * b(k, j);
+            }
+            c(i, j) = sum;
+        }
+    }
+}
+
+// Runtime-sized, row-major matrix with 64-byte aligned, move-only heap storage.
+// Offers the same operations as Matrix; use clone() for an explicit deep copy.
+template <typename T>
+class DynMatrix {
+public:
+    DynMatrix() = default;
+    DynMatrix(int rows, int cols) : storage(static_cast<size_t>(rows) * cols), numRows(rows), numCols(cols) {}
+
+    // Constructor from initializer list
+    DynMatrix(std::initializer_list<std::initializer_list<T>> values)
+        : DynMatrix(static_cast<int>(values.size()), values.size() ? static_cast<int>(values.begin()->size()) : 0) {
+        int i = 0;
+        for (const auto& row : values) {
+            assert(static_cast<int>(row.size()) == numCols);
+            std::copy(row.begin(), row.end(), (*this)[i++]);
+        }
+    }
+
+    template <int R, int C>
+    explicit DynMatrix(const Matrix<T, R, C>& m) : DynMatrix(R, C) {
+        for (int i = 0; i < R; ++i) {
+            std::copy(m[i].begin(), m[i].end(), (*this)[i]);
+        }
+    }
+
+    // Moves leave the source an empty 0 x 0 matrix, so its dimensions always match its storage
+    DynMatrix(DynMatrix&& other) noexcept
+        : storage(std::move(other.storage)), numRows(std::exchange(other.numRows, 0)), numCols(std::exchange(other.numCols, 0)) {}
+    DynMatrix& operator=(DynMatrix&& other) noexcept {
+        if (this != &other) {
+            storage = std::move(other.storage);
+            numRows = std::exchange(other.numRows, 0);
+            numCols = std::exchange(other.numCols, 0);
+        }
+        return *this;
+    }
+
+    DynMatrix clone() const {
+        DynMatrix result(numRows, numCols);
+        std::copy_n(data(), size(), result.data());
+        return result;
+    }
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    size_t size() const { return storage.size(); }
+    T* data() { return storage.data(); }
+    const T* data() const { return storage.data(); }
+
+    // Views and fixed-size interop
+    MatrixView<T> view() { return MatrixView<T>(data(), numRows, numCols, numCols); }
+    MatrixView<const T> view() const { return MatrixView<const T>(data(), numRows, numCols, numCols); }
+
+    template <int R, int C>
+    Matrix<T, R, C> to_fixed() const {
+        assert(numRows == R && numCols == C);
+        Matrix<T, R, C> result;
+        for (int i = 0; i < R; ++i) {
+            std::copy_n((*this)[i], C, result[i].begin());
+        }
+        return result;
+    }
+
+    // Element-wise matrix operations
+    DynMatrix operator+(const DynMatrix& other) const { return apply(other, std::plus<>()); }
+    DynMatrix operator-(const DynMatrix& other) const { return apply(other, std::minus<>()); }
+    DynMatrix operator*(const DynMatrix& other) const { return multiply(other); }
+
+    DynMatrix& operator+=(const DynMatrix& other) { return apply_self(other, std::plus<>()); }
+    DynMatrix& operator-=(const DynMatrix& other) { return apply_self(other, std::minus<>()); }
+    DynMatrix& operator*=(const DynMatrix& other) { return *this = multiply(other); }
+
+    // Scalar operations
+    DynMatrix operator+(const T& scalar) const { return apply_scalar(scalar, std::plus<>()); }
+    DynMatrix operator-(const T& scalar) const { return apply_scalar(scalar, std::minus<>()); }
+    DynMatrix operator*(const T& scalar) const { return apply_scalar(scalar, std::multiplies<>()); }
+    DynMatrix operator/(const T& scalar) const { return apply_scalar(scalar, std::divides<>()); }
+
+    DynMatrix& operator+=(const T& scalar) { return apply_scalar_self(scalar, std::plus<>()); }
+    DynMatrix& operator-=(const T& scalar) { return apply_scalar_self(scalar, std::minus<>()); }
+    DynMatrix& operator*=(const T& scalar) { return apply_scalar_self(scalar, std::multiplies<>()); }
+    DynMatrix& operator/=(const T& scalar) { return apply_scalar_self(scalar, std::divides<>()); }
+
+    // Matrix utilities
+    DynMatrix transpose() const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixTranspose, 0);
+        DynMatrix result(numCols, numRows);
+        if (numRows >= TINYMATH_TRANSPOSE_BLOCKED_MIN_DIM && numCols >= TINYMATH_TRANSPOSE_BLOCKED_MIN_DIM) {
+            transpose_blocked(numRows, numCols, data(), numCols, result.data(), numRows);
+            return result;
+        }
+        for (int i = 0; i < numRows; ++i) {
+            for (int j = 0; j < numCols; ++j) {
+                result[j][i] = (*this)[i][j];
+            }
+        }
+        return result;
+    }
+
+    // Square matrices are transposed in place; other shapes go through a new buffer of the same size
+    DynMatrix& transpose_inplace() {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixTranspose, 0);
+        if (numRows != numCols) {
+            *this = transpose();
+            return *this;
+        }
+        if (numRows >= TINYMATH_TRANSPOSE_BLOCKED_MIN_DIM) {
+            transpose_square_blocked(numRows, data(), numCols);
+            return *this;
+        }
+        for (int i = 0; i < numRows; ++i) {
+            for (int j = i + 1; j < numCols; ++j) {
+                std::swap((*this)[i][j], (*this)[j][i]);
+            }
+        }
+        return *this;
+    }
+
+    // Vector transformation (multiply matrix by vector); Policy picks the accumulation mode (see MathUtils.hpp)
+    template <typename Policy = DefaultAccumulation>
+    DynVector<T> transform(const DynVector<T>& vec) const {
+        assert(static_cast<int>(vec.size()) == numCols);
+        TINYMATH_INSTRUMENT_SCOPE(MatrixTransform, 2.0 * numRows * numCols);
+        DynVector<T> result(numRows);
+        if constexpr (SimdMatVecKernel<T>::enabled && !std::is_same_v<Policy, ExactAccumulation>) {
+            if (numCols >= SimdMatVecKernel<T>::width) {
+                SimdMatVecKernel<T>::template dot_rows<Policy>(numRows, numCols, data(), numCols, vec.data(), result.data());
+                return result;
+            }
+        }
+        for (int i = 0; i < numRows; ++i) {
+            const T* row = (*this)[i];
+            T sum = 0;
+            for (int j = 0; j < numCols; ++j) {
+                sum = multiply_add<Policy>(row[j], vec[j], sum);
+            }
+            result[i] = sum;
+        }
+        return result;
+    }
+
+    // transpose() * vec without materializing the transpose: the rows scaled by the vector components and summed
+    template <typename Policy = DefaultAccumulation>
+    DynVector<T> transpose_multiply(const DynVector<T>& vec) const {
+        assert(static_cast<int>(vec.size()) == numRows);
+        TINYMATH_INSTRUMENT_SCOPE(MatrixTransposeMultiply, 2.0 * numRows * numCols);
+        DynVector<T> result(numCols);
+        if (numRows == 0)
+            return result;
+        if constexpr (SimdMatVecKernel<T>::enabled && !std::is_same_v<Policy, ExactAccumulation>) {
+            if (numCols >= SimdMatVecKernel<T>::width) {
+                SimdMatVecKernel<T>::template combine_rows<Policy>(numRows, numCols, data(), numCols, vec.data(), result.data());
+                return result;
+            }
+        }
+        for (int j = 0; j < numCols; ++j) {
+            result[j] = (*this)[0][j] * vec[0];
+        }
+        for (int i = 1; i < numRows; ++i) {
+            const T* row = (*this)[i];
+            for (int j = 0; j < numCols; ++j) {
+                result[j] = multiply_add<Policy>(row[j], vec[i], result[j]);
+            }
+        }
+        return result;
+    }
+
+    // Operators
+    bool operator==(const DynMatrix& other) const {
+        return numRows == other.numRows && numCols == other.numCols && std::equal(data(), data() + size(), other.data());
+    }
+    bool operator!=(const DynMatrix& other) const { return !(*this == other); }
+    T* operator[](size_t index) { return data() + index * numCols; }
+    const T* operator[](size_t index) const { return data() + index * numCols; }
+
+    void print() const {
+        for (int i = 0; i < numRows; ++i) {
+            std::cout << "[ ";
+            for (int j = 0; j < numCols; ++j) {
+                std::cout << (*this)[i][j] << (j < numCols - 1 ? ", " : "");
+            }
+            std::cout << " ]\n";
+        }
+    }
+
+private:
+    AlignedBuffer<T> storage;
+    int numRows = 0;
+    int numCols = 0;
+
+    template <typename Op>
+    DynMatrix apply(const DynMatrix& other, Op op) const {
+        assert(other.numRows == numRows && other.numCols == numCols);
+        TINYMATH_INSTRUMENT_SCOPE(MatrixElementwise, size());
+        DynMatrix result(numRows, numCols);
+        std::transform(data(), data() + size(), other.data(), result.data(), op);
+        return result;
+    }
+
+    template <typename Op>
+    DynMatrix& apply_self(const DynMatrix& other, Op op) {
+        assert(other.numRows == numRows && other.numCols == numCols);
+        TINYMATH_INSTRUMENT_SCOPE(MatrixElementwise, size());
+        std::transform(data(), data() + size(), other.data(), data(), op);
+        return *this;
+    }
+
+    template <typename Op>
+    DynMatrix apply_scalar(const T& scalar, Op op) const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixElementwise, size());
+        DynMatrix result(numRows, numCols);
+        std::transform(data(), data() + size(), result.data(), [&](T x) { return op(x, scalar); });
+        return result;
+    }
+
+    template <typename Op>
+    DynMatrix& apply_scalar_self(const T& scalar, Op op) {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixElementwise, size());
+        std::transform(data(), data() + size(), data(), [&](T x) { return op(x, scalar); });
+        return *this;
+    }
+
+    DynMatrix multiply(const DynMatrix& other) const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixMultiply, 2.0 * numRows * numCols * other.numCols);
+        DynMatrix result(numRows, other.numCols);
+        multiply_into<T>(view(), other.view(), result.view());
+        return result;
+    }
+};
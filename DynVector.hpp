@@ -0,0 +1,190 @@
+#pragma once
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <span>
+#include "AlignedAllocator.hpp"
+#include "Instrumentation.hpp"
+#include "Vector.hpp"
+
+// Runtime-sized vector with 64-byte aligned, move-only heap storage.
+// Offers the same operations as Vector; use clone() for an explicit deep copy.
+template <typename T>
+class DynVector {
+public:
+    DynVector() = default;
+    explicit DynVector(size_t size) : storage(size) {}
+    DynVector(std::initializer_list<T> values) : storage(values.size()) {
+        std::copy(values.begin(), values.end(), storage.data());
+    }
+    template <int N>
+    explicit DynVector(const Vector<T, N>& vec) : storage(N) {
+        std::copy(vec.data.begin(), vec.data.end(), storage.data());
+    }
+
+    DynVector(DynVector&&) noexcept = default;
+    DynVector& operator=(DynVector&&) noexcept = default;
+
+    DynVector clone() const {
+        DynVector result(size());
+        std::copy_n(data(), size(), result.data());
+        return result;
+    }
+
+    size_t size() const { return storage.size(); }
+    T* data() { return storage.data(); }
+    const T* data() const { return storage.data(); }
+
+    // Views and fixed-size interop
+    std::span<T> span() { return { data(), size() }; }
+    std::span<const T> span() const { return { data(), size() }; }
+
+    template <int N>
+    Vector<T, N> to_fixed() const {
+        assert(size() == N);
+        Vector<T, N> result;
+        std::copy_n(data(), N, result.data.begin());
+        return result;
+    }
+
+    // Element-wise vector operations
+    DynVector operator+(const DynVector& other) const { return apply(other, std::plus<>()); }
+    DynVector operator-(const DynVector& other) const { return apply(other, std::minus<>()); }
+    DynVector operator*(const DynVector& other) const { return apply(other, std::multiplies<>()); }
+    DynVector operator/(const DynVector& other) const { return apply(other, std::divides<>()); }
+
+    DynVector& operator+=(const DynVector& other) { return apply_self(other, std::plus<>()); }
+    DynVector& operator-=(const DynVector& other) { return apply_self(other, std::minus<>()); }
+    DynVector& operator*=(const DynVector& other) { return apply_self(other, std::multiplies<>()); }
+    DynVector& operator/=(const DynVector& other) { return apply_self(other, std::divides<>()); }
+
+    // Scalar operations
+    DynVector operator+(const T& scalar) const { return apply_scalar(scalar, std::plus<>()); }
+    DynVector operator-(const T& scalar) const { return apply_scalar(scalar, std::minus<>()); }
+    DynVector operator*(const T& scalar) const { return apply_scalar(scalar, std::multiplies<>()); }
+    DynVector operator/(const T& scalar) const { return apply_scalar(scalar, std::divides<>()); }
+
+    DynVector& operator+=(const T& scalar) { return apply_scalar_self(scalar, std::plus<>()); }
+    DynVector& operator-=(const T& scalar) { return apply_scalar_self(scalar, std::minus<>()); }
+    DynVector& operator*=(const T& scalar) { return apply_scalar_self(scalar, std::multiplies<>()); }
+    DynVector& operator/=(const T& scalar) { return apply_scalar_self(scalar, std::divides<>()); }
+
+    // Vector utilities
+    T dot(const DynVector& other) const {
+        assert(other.size() == size());
+        TINYMATH_INSTRUMENT_SCOPE(VectorDot, 2 * size());
+        T result = 0;
+        for (size_t i = 0; i < size(); i++)
+            result += storage[i] * other.storage[i];
+        return result;
+    }
+
+    T magnitude() const {
+        TINYMATH_INSTRUMENT_SCOPE(VectorMagnitude, 2 * size() + 1);
+        return std::sqrt(dot(*this));
+    }
+
+    DynVector normalized() const {
+        TINYMATH_INSTRUMENT_SCOPE(VectorNormalize, 3 * size() + 1);
+        T mag = magnitude();
+        return (mag > 0) ? *this / mag : clone();
+    }
+
+    static T distance(const DynVector& a, const DynVector& b) {
+        return (a - b).magnitude();
+    }
+
+    DynVector& normalize() {
+        TINYMATH_INSTRUMENT_SCOPE(VectorNormalize, 3 * size() + 1);
+        T mag = magnitude();
+        return (mag > 0) ? (*this /= mag) : *this;
+    }
+
+    // Cross Product (only for 3D vectors)
+    DynVector cross(const DynVector& other) const {
+        assert(size() == 3 && other.size() == 3);
+        TINYMATH_INSTRUMENT_SCOPE(VectorCross, 9);
+        return DynVector{
+            storage[1] * other.storage[2] - storage[2] * other.storage[1],
+            storage[2] * other.storage[0] - storage[0] * other.storage[2],
+            storage[0] * other.storage[1] - storage[1] * other.storage[0]
+        };
+    }
+
+    // Clamp values within min-max range
+    DynVector clamp(const T& minVal, const T& maxVal) const {
+        DynVector result(size());
+        for (size_t i = 0; i < size(); i++)
+            result.storage[i] = std::clamp(storage[i], minVal, maxVal);
+        return result;
+    }
+
+    // Linear interpolation
+    static DynVector lerp(const DynVector& start, const DynVector& end, T t) {
+        assert(start.size() == end.size());
+        DynVector result(start.size());
+        for (size_t i = 0; i < start.size(); i++)
+            result.storage[i] = start.storage[i] + (end.storage[i] - start.storage[i]) * t;
+        return result;
+    }
+
+    // Reflection over a normal
+    DynVector reflect(const DynVector& normal) const {
+        const T scale = 2 * dot(normal);
+        DynVector result(size());
+        for (size_t i = 0; i < size(); i++)
+            result.storage[i] = storage[i] - normal.storage[i] * scale;
+        return result;
+    }
+
+    // Operators
+    bool operator==(const DynVector& other) const { return std::equal(data(), data() + size(), other.data(), other.data() + other.size()); }
+    bool operator!=(const DynVector& other) const { return !(*this == other); }
+    DynVector operator-() const { return *this * T(-1); }
+    T& operator[](size_t index) { return storage[index]; }
+    const T& operator[](size_t index) const { return storage[index]; }
+
+    void print() const {
+        std::cout << "(";
+        for (size_t i = 0; i < size(); i++)
+            std::cout << storage[i] << (i < size() - 1 ? ", " : "");
+        std::cout << ")\n";
+    }
+
+private:
+    AlignedBuffer<T> storage;
+
+    template <typename Op>
+    DynVector apply(const DynVector& other, Op op) const {
+        assert(other.size() == size());
+        TINYMATH_INSTRUMENT_SCOPE(VectorElementwise, size());
+        DynVector result(size());
+        std::transform(data(), data() + size(), other.data(), result.data(), op);
+        return result;
+    }
+
+    template <typename Op>
+    DynVector& apply_self(const DynVector& other, Op op) {
+        assert(other.size() == size());
+        TINYMATH_INSTRUMENT_SCOPE(VectorElementwise, size());
+        std::transform(data(), data() + size(), other.data(), data(), op);
+        return *this;
+    }
+
+    template <typename Op>
+    DynVector apply_scalar(const T& scalar, Op op) const {
+        TINYMATH_INSTRUMENT_SCOPE(VectorElementwise, size());
+        DynVector result(size());
+        std::transform(data(), data() + size(), result.data(), [&](T x) { return op(x, scalar); });
+        return result;
+    }
+
+    template <typename Op>
+    DynVector& apply_scalar_self(const T& scalar, Op op) {
+        TINYMATH_INSTRUMENT_SCOPE(VectorElementwise, size());
+        std::transform(data(), data() + size(), data(), [&](T x) { return op(x, scalar); });
+        return *this;
+    }
+};
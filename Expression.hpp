@@ -0,0 +1,224 @@
+#pragma once
+#include <functional>
+#include <type_traits>
+#include "MathUtils.hpp"
+
+// Lazy element-wise expressions for Vector and Matrix.
+// Wrap operands with lazy(...) to build an expression tree instead of a temporary per operator; the tree is
+// evaluated in a single fused loop when it is assigned to (or used to construct) a Vector or Matrix:
+//
+//     Vector<float, 3> r = lazy(a) + (lazy(b) - lazy(a)) * t;   // one loop, no intermediate Vectors
+//
+// Leaves hold references, so an expression must not outlive the operands it was built from.
+
+template <typename T, int N> class Vector;
+template <typename T, int Rows, int Cols, typename Layout> class Matrix;
+
+// --- Vector expressions ---
+
+template <typename E>
+struct VectorExpr {
+    constexpr const E& self() const { return static_cast<const E&>(*this); }
+};
+
+template <typename T, int N>
+struct VectorRef : VectorExpr<VectorRef<T, N>> {
+    using value_type = T;
+    static constexpr int size = N;
+
+    const Vector<T, N>& vec;
+
+    constexpr explicit VectorRef(const Vector<T, N>& v) : vec(v) {}
+    constexpr T operator[](size_t i) const { return vec.data[i]; }
+};
+
+template <typename L, typename R, typename Op>
+struct VectorBinaryExpr : VectorExpr<VectorBinaryExpr<L, R, Op>> {
+    using value_type = typename L::value_type;
+    static constexpr int size = L::size;
+    static_assert(L::size == R::size, "Vector expression operands must have the same size.");
+
+    L lhs;
+    R rhs;
+
+    constexpr VectorBinaryExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
+    constexpr value_type operator[](size_t i) const { return Op()(lhs[i], rhs[i]); }
+};
+
+template <typename L, typename Op>
+struct VectorScalarExpr : VectorExpr<VectorScalarExpr<L, Op>> {
+    using value_type = typename L::value_type;
+    static constexpr int size = L::size;
+
+    L lhs;
+    value_type scalar;
+
+    constexpr VectorScalarExpr(const L& l, const value_type& s) : lhs(l), scalar(s) {}
+    constexpr value_type operator[](size_t i) const { return Op()(lhs[i], scalar); }
+};
+
+template <typename L>
+struct VectorNegateExpr : VectorExpr<VectorNegateExpr<L>> {
+    using value_type = typename L::value_type;
+    static constexpr int size = L::size;
+
+    L lhs;
+
+    constexpr explicit VectorNegateExpr(const L& l) : lhs(l) {}
+    constexpr value_type operator[](size_t i) const { return -lhs[i]; }
+};
+
+template <typename T, int N>
+constexpr VectorRef<T, N> lazy(const Vector<T, N>& vec) { return VectorRef<T, N>(vec); }
+
+template <typename E>
+inline constexpr bool is_vector_expr = std::is_base_of_v<VectorExpr<E>, E>;
+
+template <typename T>
+struct is_vector_type : std::false_type {};
+template <typename T, int N>
+struct is_vector_type<Vector<T, N>> : std::true_type {};
+
+// A Vector mixed into an expression joins it by reference instead of being evaluated first
+template <typename E>
+constexpr decltype(auto) as_vector_expr(const E& e) {
+    if constexpr (is_vector_type<E>::value) return lazy(e);
+    else return (e);
+}
+
+template <typename L, typename R>
+concept VectorExprOperands = (is_vector_expr<L> || is_vector_expr<R>) &&
+                             (is_vector_expr<L> || is_vector_type<L>::value) &&
+                             (is_vector_expr<R> || is_vector_type<R>::value);
+
+template <typename Op, typename L, typename R>
+constexpr auto make_vector_expr(const L& l, const R& r) {
+    using LE = std::decay_t<decltype(as_vector_expr(l))>;
+    using RE = std::decay_t<decltype(as_vector_expr(r))>;
+    return VectorBinaryExpr<LE, RE, Op>(as_vector_expr(l), as_vector_expr(r));
+}
+
+template <typename L, typename R> requires VectorExprOperands<L, R>
+constexpr auto operator+(const L& l, const R& r) { return make_vector_expr<std::plus<>>(l, r); }
+template <typename L, typename R> requires VectorExprOperands<L, R>
+constexpr auto operator-(const L& l, const R& r) { return make_vector_expr<std::minus<>>(l, r); }
+template <typename L, typename R> requires VectorExprOperands<L, R>
+constexpr auto operator*(const L& l, const R& r) { return make_vector_expr<std::multiplies<>>(l, r); }
+template <typename L, typename R> requires VectorExprOperands<L, R>
+constexpr auto operator/(const L& l, const R& r) { return make_vector_expr<std::divides<>>(l, r); }
+
+template <typename L> requires is_vector_expr<L>
+constexpr auto operator+(const L& l, const typename L::value_type& s) { return VectorScalarExpr<L, std::plus<>>(l, s); }
+template <typename L> requires is_vector_expr<L>
+constexpr auto operator-(const L& l, const typename L::value_type& s) { return VectorScalarExpr<L, std::minus<>>(l, s); }
+template <typename L> requires is_vector_expr<L>
+constexpr auto operator*(const L& l, const typename L::value_type& s) { return VectorScalarExpr<L, std::multiplies<>>(l, s); }
+template <typename L> requires is_vector_expr<L>
+constexpr auto operator/(const L& l, const typename L::value_type& s) { return VectorScalarExpr<L, std::divides<>>(l, s); }
+
+template <typename L> requires is_vector_expr<L>
+constexpr auto operator-(const L& l) { return VectorNegateExpr<L>(l); }
+
+// --- Matrix expressions (element-wise only: Matrix * Matrix stays a matrix product) ---
+
+template <typename E>
+struct MatrixExpr {
+    constexpr const E& self() const { return static_cast<const E&>(*this); }
+};
+
+template <typename T, int Rows, int Cols, typename Layout>
+struct MatrixRef : MatrixExpr<MatrixRef<T, Rows, Cols, Layout>> {
+    using value_type = T;
+    static constexpr int rows = Rows;
+    static constexpr int cols = Cols;
+
+    const Matrix<T, Rows, Cols, Layout>& mat;
+
+    constexpr explicit MatrixRef(const Matrix<T, Rows, Cols, Layout>& m) : mat(m) {}
+    constexpr T operator()(int i, int j) const { return mat(i, j); }
+};
+
+template <typename L, typename R, typename Op>
+struct MatrixBinaryExpr : MatrixExpr<MatrixBinaryExpr<L, R, Op>> {
+    using value_type = typename L::value_type;
+    static constexpr int rows = L::rows;
+    static constexpr int cols = L::cols;
+    static_assert(L::rows == R::rows && L::cols == R::cols, "Matrix expression operands must have the same shape.");
+
+    L lhs;
+    R rhs;
+
+    constexpr MatrixBinaryExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
+    constexpr value_type operator()(int i, int j) const { return Op()(lhs(i, j), rhs(i, j)); }
+};
+
+template <typename L, typename Op>
+struct MatrixScalarExpr : MatrixExpr<MatrixScalarExpr<L, Op>> {
+    using value_type = typename L::value_type;
+    static constexpr int rows = L::rows;
+    static constexpr int cols = L::cols;
+
+    L lhs;
+    value_type scalar;
+
+    constexpr MatrixScalarExpr(const L& l, const value_type& s) : lhs(l), scalar(s) {}
+    constexpr value_type operator()(int i, int j) const { return Op()(lhs(i, j), scalar); }
+};
+
+template <typename L>
+struct MatrixNegateExpr : MatrixExpr<MatrixNegateExpr<L>> {
+    using value_type = typename L::value_type;
+    static constexpr int rows = L::rows;
+    static constexpr int cols = L::cols;
+
+    L lhs;
+
+    constexpr explicit MatrixNegateExpr(const L& l) : lhs(l) {}
+    constexpr value_type operator()(int i, int j) const { return -lhs(i, j); }
+};
+
+template <typename T, int Rows, int Cols, typename Layout>
+constexpr MatrixRef<T, Rows, Cols, Layout> lazy(const Matrix<T, Rows, Cols, Layout>& mat) { return MatrixRef<T, Rows, Cols, Layout>(mat); }
+
+template <typename E>
+inline constexpr bool is_matrix_expr = std::is_base_of_v<MatrixExpr<E>, E>;
+
+template <typename T>
+struct is_matrix_type : std::false_type {};
+template <typename T, int Rows, int Cols, typename Layout>
+struct is_matrix_type<Matrix<T, Rows, Cols, Layout>> : std::true_type {};
+
+template <typename E>
+constexpr decltype(auto) as_matrix_expr(const E& e) {
+    if constexpr (is_matrix_type<E>::value) return lazy(e);
+    else return (e);
+}
+
+template <typename L, typename R>
+concept MatrixExprOperands = (is_matrix_expr<L> || is_matrix_expr<R>) &&
+                             (is_matrix_expr<L> || is_matrix_type<L>::value) &&
+                             (is_matrix_expr<R> || is_matrix_type<R>::value);
+
+template <typename Op, typename L, typename R>
+constexpr auto make_matrix_expr(const L& l, const R& r) {
+    using LE = std::decay_t<decltype(as_matrix_expr(l))>;
+    using RE = std::decay_t<decltype(as_matrix_expr(r))>;
+    return MatrixBinaryExpr<LE, RE, Op>(as_matrix_expr(l), as_matrix_expr(r));
+}
+
+template <typename L, typename R> requires MatrixExprOperands<L, R>
+constexpr auto operator+(const L& l, const R& r) { return make_matrix_expr<std::plus<>>(l, r); }
+template <typename L, typename R> requires MatrixExprOperands<L, R>
+constexpr auto operator-(const L& l, const R& r) { return make_matrix_expr<std::minus<>>(l, r); }
+
+template <typename L> requires is_matrix_expr<L>
+constexpr auto operator+(const L& l, const typename L::value_type& s) { return MatrixScalarExpr<L, std::plus<>>(l, s); }
+template <typename L> requires is_matrix_expr<L>
+constexpr auto operator-(const L& l, const typename L::value_type& s) { return MatrixScalarExpr<L, std::minus<>>(l, s); }
+template <typename L> requires is_matrix_expr<L>
+constexpr auto operator*(const L& l, const typename L::value_type& s) { return MatrixScalarExpr<L, std::multiplies<>>(l, s); }
+template <typename L> requires is_matrix_expr<L>
+constexpr auto operator/(const L& l, const typename L::value_type& s) { return MatrixScalarExpr<L, std::divides<>>(l, s); }
+
+template <typename L> requires is_matrix_expr<L>
+constexpr auto operator-(const L& l) { return MatrixNegateExpr<L>(l); }
@@ -0,0 +1,144 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "Config.hpp"
+#include "ThreadPool.hpp"
+
+// Cache-blocked, optionally multithreaded GEMM used by Matrix::multiply above TINYMATH_GEMM_BLOCKED_MIN_DIM.
+// Operands are described by a base pointer plus row and column strides, so any dense layout can be passed in
+// without copying; the packing step rearranges each block into the contiguous order the micro-kernel streams.
+
+// Block sizes: an MR x NR tile of C lives in registers (NR spans 32 bytes, one AVX or two SSE registers),
+// an MC x KC block of A stays in L2 and a KC x NC panel of B stays in L3 while the tile loops run.
+template <typename T>
+struct GemmBlocking {
+    static constexpr int MR = 6;
+    static constexpr int NR = sizeof(T) >= 32 ? 1 : static_cast<int>(32 / sizeof(T));
+    static constexpr int KC = 256;
+    static constexpr int MC = 96;
+    static constexpr int NC = 2048;
+};
+
+// Packs an mc x kc block of A into MR-row slivers, each stored column by column (zero-padded to MR rows)
+template <typename T>
+void gemm_pack_a(int mc, int kc, const T* a, std::ptrdiff_t rs, std::ptrdiff_t cs, T* packed) {
+    constexpr int MR = GemmBlocking<T>::MR;
+    for (int i = 0; i < mc; i += MR) {
+        const int mr = std::min(MR, mc - i);
+        for (int p = 0; p < kc; ++p) {
+            for (int ii = 0; ii < mr; ++ii)
+                packed[ii] = a[(i + ii) * rs + p * cs];
+            for (int ii = mr; ii < MR; ++ii)
+                packed[ii] = T(0);
+            packed += MR;
+        }
+    }
+}
+
+// Packs a kc x nc panel of B into NR-column slivers, each stored row by row (zero-padded to NR columns)
+template <typename T>
+void gemm_pack_b(int kc, int nc, const T* b, std::ptrdiff_t rs, std::ptrdiff_t cs, T* packed) {
+    constexpr int NR = GemmBlocking<T>::NR;
+    for (int j = 0; j < nc; j += NR) {
+        const int nr = std::min(NR, nc - j);
+        for (int p = 0; p < kc; ++p) {
+            for (int jj = 0; jj < nr; ++jj)
+                packed[jj] = b[p * rs + (j + jj) * cs];
+            for (int jj = nr; jj < NR; ++jj)
+                packed[jj] = T(0);
+            packed += NR;
+        }
+    }
+}
+
+// MR x NR register tile: rank-1 updates over kc, then the valid mr x nr corner is written (or accumulated) into C
+template <typename T>
+void gemm_micro_kernel(int kc, const T* a, const T* b, T* c, std::ptrdiff_t rs, std::ptrdiff_t cs,
+                       int mr, int nr, bool accumulate) {
+    constexpr int MR = GemmBlocking<T>::MR;
+    constexpr int NR = GemmBlocking<T>::NR;
+    T acc[MR][NR] = {};
+    for (int p = 0; p < kc; ++p) {
+        // Written as a plain multiply-add so the compiler keeps the tile in vector registers and contracts it to FMA;
+        // std::fma here blocks vectorization of the float tile
+        for (int i = 0; i < MR; ++i) {
+            const T ai = a[i];
+            for (int j = 0; j < NR; ++j)
+                acc[i][j] += ai * b[j];
+        }
+        a += MR;
+        b += NR;
+    }
+    for (int i = 0; i < mr; ++i) {
+        for (int j = 0; j < nr; ++j) {
+            T& out = c[i * rs + j * cs];
+            out = accumulate ? out + acc[i][j] : acc[i][j];
+        }
+    }
+}
+
+// C (m x n) = A (m x k) * B (k x n) on the calling thread
+template <typename T>
+void gemm_serial(int m, int n, int k,
+          const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+          const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+          T* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+    using B = GemmBlocking<T>;
+    if (k == 0) {
+        for (int i = 0; i < m; ++i)
+            for (int j = 0; j < n; ++j)
+                c[i * rsc + j * csc] = T(0);
+        return;
+    }
+
+    thread_local std::vector<T> packed_a, packed_b;
+    const std::size_t kc_max = std::min(B::KC, k);
+    packed_a.resize((std::min(B::MC, m) + B::MR) * kc_max);
+    packed_b.resize((std::min(B::NC, n) + B::NR) * kc_max);
+
+    for (int jc = 0; jc < n; jc += B::NC) {
+        const int nc = std::min(B::NC, n - jc);
+        for (int pc = 0; pc < k; pc += B::KC) {
+            const int kc = std::min(B::KC, k - pc);
+            gemm_pack_b(kc, nc, b + pc * rsb + jc * csb, rsb, csb, packed_b.data());
+            for (int ic = 0; ic < m; ic += B::MC) {
+                const int mc = std::min(B::MC, m - ic);
+                gemm_pack_a(mc, kc, a + ic * rsa + pc * csa, rsa, csa, packed_a.data());
+                for (int jr = 0; jr < nc; jr += B::NR) {
+                    for (int ir = 0; ir < mc; ir += B::MR) {
+                        gemm_micro_kernel(kc, packed_a.data() + ir * kc, packed_b.data() + jr * kc,
+                                          c + (ic + ir) * rsc + (jc + jr) * csc, rsc, csc,
+                                          std::min(B::MR, mc - ir), std::min(B::NR, nc - jr), pc > 0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// C (m x n) = A (m x k) * B (k x n).
+// Above TINYMATH_PARALLEL_GEMM_MIN_FLOPS the output is cut into independent MC x TileN tiles that the current
+// ThreadPool computes concurrently, each with its own packing buffers; smaller products stay serial.
+template <typename T>
+void gemm(int m, int n, int k,
+          const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+          const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+          T* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+    using B = GemmBlocking<T>;
+    constexpr int TileN = 32 * B::NR;
+    ThreadPool& pool = ThreadPool::current();
+    if (pool.size() == 1 || 2.0 * m * n * k < TINYMATH_PARALLEL_GEMM_MIN_FLOPS) {
+        gemm_serial(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc);
+        return;
+    }
+
+    const int tiles_m = (m + B::MC - 1) / B::MC;
+    const int tiles_n = (n + TileN - 1) / TileN;
+    pool.run(static_cast<size_t>(tiles_m) * tiles_n, [&](size_t tile) {
+        const int i = static_cast<int>(tile / tiles_n) * B::MC;
+        const int j = static_cast<int>(tile % tiles_n) * TileN;
+        gemm_serial(std::min(B::MC, m - i), std::min(TileN, n - j), k,
+                    a + i * rsa, rsa, csa, b + j * csb, rsb, csb, c + i * rsc + j * csc, rsc, csc);
+    });
+}
@@ -0,0 +1,234 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Config.hpp"
+
+// Opt-in per-operation counters (see TINYMATH_INSTRUMENT in Config.hpp). Each instrumented Vector, Matrix,
+// DynVector and DynMatrix operation adds one call, an estimate of its floating-point operations and its wall time to
+// counters owned by the calling thread. instrumentation_snapshot() sums them over every thread that has recorded
+// anything, and reset_instrumentation() zeroes them:
+//
+//     reset_instrumentation();
+//     run_frame();
+//     std::cout << instrumentation_snapshot().to_json() << "\n";
+//
+// Only the outermost instrumented call on a thread is recorded, so normalize() counts as one normalize rather than
+// also as a magnitude and a division, and its time covers the whole call. ThreadPool jobs run at the depth of the
+// thread that submitted them, so the per-element calls of a batch split across threads are not recorded either.
+// Constant-evaluated calls are not counted.
+// Without TINYMATH_INSTRUMENT the hooks expand to nothing and snapshots stay empty.
+
+enum class InstrumentedOp {
+    VectorElementwise,
+    VectorDot,
+    VectorCross,
+    VectorMagnitude,
+    VectorNormalize,
+    VectorNormalizeBatch,
+    VectorScaleBatch,
+    VectorReduction,
+    MatrixElementwise,
+    MatrixMultiply,
+    MatrixTransform,
+    MatrixTransposeMultiply,
+    MatrixTransformBatch,
+    MatrixTranspose,
+    MatrixDeterminant,
+    MatrixInverse,
+    Count
+};
+
+inline constexpr size_t instrumented_op_count = static_cast<size_t>(InstrumentedOp::Count);
+
+constexpr const char* instrumented_op_name(InstrumentedOp op) {
+    switch (op) {
+    case InstrumentedOp::VectorElementwise: return "vector_elementwise";
+    case InstrumentedOp::VectorDot: return "dot";
+    case InstrumentedOp::VectorCross: return "cross";
+    case InstrumentedOp::VectorMagnitude: return "magnitude";
+    case InstrumentedOp::VectorNormalize: return "normalize";
+    case InstrumentedOp::VectorNormalizeBatch: return "normalize_batch";
+    case InstrumentedOp::VectorScaleBatch: return "scale_batch";
+    case InstrumentedOp::VectorReduction: return "reduction";
+    case InstrumentedOp::MatrixElementwise: return "matrix_elementwise";
+    case InstrumentedOp::MatrixMultiply: return "multiply";
+    case InstrumentedOp::MatrixTransform: return "transform";
+    case InstrumentedOp::MatrixTransposeMultiply: return "transpose_multiply";
+    case InstrumentedOp::MatrixTransformBatch: return "transform_batch";
+    case InstrumentedOp::MatrixTranspose: return "transpose";
+    case InstrumentedOp::MatrixDeterminant: return "determinant";
+    case InstrumentedOp::MatrixInverse: return "inverse";
+    default: return "unknown";
+    }
+}
+
+struct OperationStats {
+    uint64_t calls = 0;
+    uint64_t flops = 0;
+    uint64_t nanoseconds = 0;
+};
+
+struct InstrumentationSnapshot {
+    std::array<OperationStats, instrumented_op_count> ops{};
+
+    const OperationStats& operator[](InstrumentedOp op) const { return ops[static_cast<size_t>(op)]; }
+
+    // {"dot": {"calls": 3, "flops": 24, "ns": 51}, ...}; operations that were never called are left out
+    std::string to_json() const {
+        std::string json = "{";
+        for (size_t i = 0; i < instrumented_op_count; i++) {
+            const OperationStats& s = ops[i];
+            if (s.calls == 0)
+                continue;
+            if (json.size() > 1)
+                json += ", ";
+            json += "\"";
+            json += instrumented_op_name(static_cast<InstrumentedOp>(i));
+            json += "\": {\"calls\": " + std::to_string(s.calls) + ", \"flops\": " + std::to_string(s.flops) +
+                    ", \"ns\": " + std::to_string(s.nanoseconds) + "}";
+        }
+        return json + "}";
+    }
+};
+
+// Thread-local counter storage. Each thread's counters are written only by that thread (relaxed atomics, so a
+// concurrent snapshot reads them without a data race) and are folded into a shared total when the thread exits.
+class Instrumentation {
+public:
+    static void record(InstrumentedOp op, uint64_t flops, uint64_t nanoseconds) {
+        Counters& counters = local().counters[static_cast<size_t>(op)];
+        counters.calls.fetch_add(1, std::memory_order_relaxed);
+        counters.flops.fetch_add(flops, std::memory_order_relaxed);
+        counters.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    // Depth of instrumented calls on this thread; only depth 1 records
+    static int& depth() {
+        thread_local int value = 0;
+        return value;
+    }
+
+    static InstrumentationSnapshot snapshot() {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        InstrumentationSnapshot result = retired();
+        for (const ThreadCounters* thread : registry()) {
+            for (size_t i = 0; i < instrumented_op_count; i++) {
+                result.ops[i].calls += thread->counters[i].calls.load(std::memory_order_relaxed);
+                result.ops[i].flops += thread->counters[i].flops.load(std::memory_order_relaxed);
+                result.ops[i].nanoseconds += thread->counters[i].nanoseconds.load(std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+
+    static void reset() {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        retired() = InstrumentationSnapshot();
+        for (ThreadCounters* thread : registry()) {
+            for (Counters& counters : thread->counters) {
+                counters.calls.store(0, std::memory_order_relaxed);
+                counters.flops.store(0, std::memory_order_relaxed);
+                counters.nanoseconds.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Counters {
+        std::atomic<uint64_t> calls{ 0 };
+        std::atomic<uint64_t> flops{ 0 };
+        std::atomic<uint64_t> nanoseconds{ 0 };
+    };
+
+    struct ThreadCounters {
+        std::array<Counters, instrumented_op_count> counters;
+
+        ThreadCounters() {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            registry().push_back(this);
+        }
+
+        ~ThreadCounters() {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            auto& threads = registry();
+            std::erase(threads, this);
+            for (size_t i = 0; i < instrumented_op_count; i++) {
+                retired().ops[i].calls += counters[i].calls.load(std::memory_order_relaxed);
+                retired().ops[i].flops += counters[i].flops.load(std::memory_order_relaxed);
+                retired().ops[i].nanoseconds += counters[i].nanoseconds.load(std::memory_order_relaxed);
+            }
+        }
+    };
+
+    static ThreadCounters& local() {
+        thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    // The shared state is never destroyed: ThreadPool workers can exit, and fold in their counters, during static
+    // destruction
+    static std::vector<ThreadCounters*>& registry() {
+        static auto* threads = new std::vector<ThreadCounters*>();
+        return *threads;
+    }
+
+    // Totals of threads that have exited
+    static InstrumentationSnapshot& retired() {
+        static auto* totals = new InstrumentationSnapshot();
+        return *totals;
+    }
+
+    static std::mutex& registry_mutex() {
+        static auto* m = new std::mutex();
+        return *m;
+    }
+};
+
+inline InstrumentationSnapshot instrumentation_snapshot() { return Instrumentation::snapshot(); }
+inline void reset_instrumentation() { Instrumentation::reset(); }
+
+// Records one call of op with the given flop estimate when it goes out of scope. A literal type, so the hooks can
+// sit in constexpr functions; the clock and the counters are only touched outside constant evaluation.
+class InstrumentationScope {
+public:
+    constexpr InstrumentationScope(InstrumentedOp op, uint64_t flops) : op(op), flops(flops) {
+        if (!std::is_constant_evaluated()) {
+            outermost = ++Instrumentation::depth() == 1;
+            if (outermost)
+                start = std::chrono::steady_clock::now();
+        }
+    }
+
+    InstrumentationScope(const InstrumentationScope&) = delete;
+    InstrumentationScope& operator=(const InstrumentationScope&) = delete;
+
+    constexpr ~InstrumentationScope() {
+        if (!std::is_constant_evaluated()) {
+            if (outermost) {
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+                Instrumentation::record(op, flops, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+            --Instrumentation::depth();
+        }
+    }
+
+private:
+    InstrumentedOp op;
+    uint64_t flops;
+    bool outermost = false;
+    std::chrono::steady_clock::time_point start{};
+};
+
+#ifdef TINYMATH_INSTRUMENT
+    #define TINYMATH_INSTRUMENT_SCOPE(op, flops) \
+        InstrumentationScope tinymath_instrumentation_scope(InstrumentedOp::op, static_cast<uint64_t>(flops))
+#else
+    #define TINYMATH_INSTRUMENT_SCOPE(op, flops) ((void)0)
+#endif
@@ -1,4 +1,16 @@
-#pragma once
-
-#include "Vector.hpp"
-#include "Matrix.hpp"
\ No newline at end of file
+#pragma once
+
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "VectorBatch.hpp"
+#include "MatrixBatch.hpp"
+#include "Decomposition.hpp"
+#include "Quaternion.hpp"
+#include "Affine3.hpp"
+#include "DynVector.hpp"
+#include "DynMatrix.hpp"
+#include "DistanceMatrix.hpp"
+#include "PointIndex.hpp"
+#include "Reduction.hpp"
+#include "Streaming.hpp"
+#include "Instrumentation.hpp"
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include "Config.hpp"
+
+// Square root usable in constant expressions: std::sqrt at run time, Newton iteration at compile time.
+// The iteration runs in a wider type so the rounded result agrees with std::sqrt (barring rare double rounding);
+// integral arguments are evaluated in double, like std::sqrt.
+template <typename T>
+constexpr auto math_sqrt(T x) {
+    using R = std::conditional_t<std::is_integral_v<T>, double, T>;
+    if (!std::is_constant_evaluated())
+        return std::sqrt(x);
+
+    using W = std::conditional_t<(sizeof(R) < sizeof(double)), double, long double>;
+    const W value = static_cast<W>(x);
+    if (value < 0 || value != value)
+        return std::numeric_limits<R>::quiet_NaN();
+    if (value == 0 || value == std::numeric_limits<W>::infinity())
+        return static_cast<R>(value);
+
+    // Starting above the root, Newton steps decrease monotonically until rounding stalls them
+    W current = value < 1 ? W(1) : value;
+    while (true) {
+        const W next = W(0.5) * (current + value / current);
+        if (next >= current)
+            break;
+        current = next;
+    }
+    return static_cast<R>(current);
+}
+
+// Absolute value usable in constant expressions (std::abs is not constexpr before C++23)
+template <typename T>
+constexpr T math_abs(T x) {
+    return x < 0 ? -x : x;
+}
+
+// Accumulation policies for dot products, Matrix::transform and Matrix::multiply
+struct ExactAccumulation {};   // sum += a * b in index order: bit-identical to the original loops
+struct FusedAccumulation {};   // fused multiply-add into independent partial sums: faster, one rounding per term
+
+#ifdef TINYMATH_LEGACY_ACCUMULATION
+using DefaultAccumulation = ExactAccumulation;
+#else
+using DefaultAccumulation = FusedAccumulation;
+#endif
+
+// Precision policies for Vector::magnitude, normalized, normalize and distance. Largest errors measured over random
+// vectors with components up to 2^+-20, in ULP of the exact result (magnitude / normalized component, SSE build):
+//
+//                        float           double
+//   ExactPrecision       1.4 / 2.4       1.5 / 2.5
+//   FastPrecision        3.5 / 4.9       2.5 / 2.9
+//   EstimatePrecision    4100 / 5500     about 2^-21 relative (float precision)
+//
+// Without SSE, FastPrecision and EstimatePrecision both divide once and multiply (at most 2.7 / 3.1 ULP).
+struct ExactPrecision {};      // std::sqrt, and a division per component when normalizing
+struct FastPrecision {};       // reciprocal square root estimate refined by one Newton-Raphson step, then multiplies
+struct EstimatePrecision {};   // the raw reciprocal square root estimate, then multiplies
+
+// Summation policies for Vector::sum and mean (see Reduction.hpp). Both add in an order fixed by the input size alone,
+// so results are the same with and without threads; integer sums are exact either way.
+struct PairwiseSummation {};   // independent partial sums per block, blocks added in a binary tree: error grows with log n
+struct KahanSummation {};      // compensated partial sums, blocks added without rounding error: error independent of n
+
+// Storage orders for Matrix
+struct RowMajor {};      // data[i] is row i (the default)
+struct ColumnMajor {};   // data[j] is column j, as expected by OpenGL/Vulkan uploads and column-major BLAS
+
+// a * b + c, fused into one rounding when the policy asks for it and the hardware has FMA
+template <typename Policy, typename T>
+constexpr T multiply_add(T a, T b, T c) {
+#ifdef TINYMATH_FMA
+    if constexpr (std::is_same_v<Policy, FusedAccumulation> && std::is_floating_point_v<T>) {
+        if (!std::is_constant_evaluated())
+            return std::fma(a, b, c);
+    }
+#endif
+    return a * b + c;
+}
+
+// Sum of a[i] * b[i] for i in [0, N). The fused policy splits long sums over four accumulators so consecutive
+// multiply-adds do not wait on each other.
+template <typename Policy, int N, typename T, typename U = T>
+constexpr T dot_product(const T* a, const U* b) {
+    if constexpr (std::is_same_v<Policy, ExactAccumulation>) {
+        T result = 0;
+        for (int i = 0; i < N; i++)
+            result += a[i] * b[i];
+        return result;
+    } else if constexpr (N >= 8) {
+        T sum[4] = { a[0] * b[0], a[1] * b[1], a[2] * b[2], a[3] * b[3] };
+        int i = 4;
+        for (; i + 4 <= N; i += 4) {
+            for (int k = 0; k < 4; k++)
+                sum[k] = multiply_add<Policy>(a[i + k], b[i + k], sum[k]);
+        }
+        for (; i < N; i++)
+            sum[0] = multiply_add<Policy>(a[i], b[i], sum[0]);
+        return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+    } else {
+        T result = a[0] * b[0];
+        for (int i = 1; i < N; i++)
+            result = multiply_add<Policy>(a[i], b[i], result);
+        return result;
+    }
+}
@@ -1,175 +1,611 @@
-#pragma once
-#include <iostream>
-#include <array>
-#include <algorithm>
-#include <type_traits>
-#include <cmath>
-
-template <typename T, int Rows, int Cols>
-class Matrix {
-public:
-    std::array<std::array<T, Cols>, Rows> data{};
-
-    // Default constructor (initialize all elements to 0)
-    Matrix() {
-        for (auto& row : data) {
-            row.fill(0);
-        }
-    }
-
-    // Constructor from initializer list
-    Matrix(std::initializer_list<std::initializer_list<T>> values) {
-        auto rowIt = values.begin();
-        for (int i = 0; i < Rows; ++i) {
-            auto colIt = rowIt->begin();
-            for (int j = 0; j < Cols; ++j) {
-                data[i][j] = *colIt++;
-            }
-            ++rowIt;
-        }
-    }
-
-    // Element-wise matrix operations
-    Matrix operator+(const Matrix& other) const { return apply(other, std::plus<>()); }
-    Matrix operator-(const Matrix& other) const { return apply(other, std::minus<>()); }
-    Matrix operator*(const Matrix& other) const { return multiply(other); }
-
-    Matrix& operator+=(const Matrix& other) { return apply_self(other, std::plus<>()); }
-    Matrix& operator-=(const Matrix& other) { return apply_self(other, std::minus<>()); }
-    Matrix& operator*=(const Matrix& other) { return *this = multiply(other); }
-
-    // Scalar operations
-    Matrix operator+(const T& scalar) const { return apply_scalar(scalar, std::plus<>()); }
-    Matrix operator-(const T& scalar) const { return apply_scalar(scalar, std::minus<>()); }
-    Matrix operator*(const T& scalar) const { return apply_scalar(scalar, std::multiplies<>()); }
-    Matrix operator/(const T& scalar) const { return apply_scalar(scalar, std::divides<>()); }
-
-    Matrix& operator+=(const T& scalar) { return apply_scalar_self(scalar, std::plus<>()); }
-    Matrix& operator-=(const T& scalar) { return apply_scalar_self(scalar, std::minus<>()); }
-    Matrix& operator*=(const T& scalar) { return apply_scalar_self(scalar, std::multiplies<>()); }
-    Matrix& operator/=(const T& scalar) { return apply_scalar_self(scalar, std::divides<>()); }
-
-    // Matrix utilities
-    Matrix transpose() const {
-        Matrix result;
-        for (int i = 0; i < Rows; ++i) {
-            for (int j = 0; j < Cols; ++j) {
-                result[j][i] = data[i][j];
-            }
-        }
-        return result;
-    }
-
-    // Vector transformation (multiply matrix by vector)
-    template <typename U = T, int N>
-    Vector<U, N> transform(const Vector<U, N>& vec) const {
-        static_assert(Rows == N, "Matrix row count must match vector size");
-        Vector<U, N> result;
-        for (int i = 0; i < Rows; ++i) {
-            result[i] = 0;
-            for (int j = 0; j < Cols; ++j) {
-                result[i] += data[i][j] * vec[j];
-            }
-        }
-        return result;
-    }
-
-    // Operators
-    bool operator==(const Matrix& other) const { return data == other.data; }
-    bool operator!=(const Matrix& other) const { return !(*this == other); }
-    std::array<T, Cols>& operator[](size_t index) { return data[index]; }
-    const std::array<T, Cols>& operator[](size_t index) const { return data[index]; }
-
-    void print() const {
-        for (size_t i = 0; i < Rows; ++i) {
-            std::cout << "[ ";
-            for (size_t j = 0; j < Cols; ++j) {
-                std::cout << data[i][j] << (j < Cols - 1 ? ", " : "");
-            }
-            std::cout << " ]\n";
-        }
-    }
-
-private:
-    template <typename Op>
-    Matrix apply(const Matrix& other, Op op) const {
-        Matrix result;
-        for (int i = 0; i < Rows; ++i) {
-            for (int j = 0; j < Cols; ++j) {
-                result[i][j] = op(data[i][j], other[i][j]);
-            }
-        }
-        return result;
-    }
-
-    template <typename Op>
-    Matrix& apply_self(const Matrix& other, Op op) {
-        for (int i = 0; i < Rows; ++i) {
-            for (int j = 0; j < Cols; ++j) {
-                data[i][j] = op(data[i][j], other[i][j]);
-            }
-        }
-        return *this;
-    }
-
-    template <typename Op>
-    Matrix apply_scalar(const T& scalar, Op op) const {
-        Matrix result;
-        for (int i = 0; i < Rows; ++i) {
-            for (int j = 0; j < Cols; ++j) {
-                result[i][j] = op(data[i][j], scalar);
-            }
-        }
-        return result;
-    }
-
-    template <typename Op>
-    Matrix& apply_scalar_self(const T& scalar, Op op) {
-        for (int i = 0; i < Rows; ++i) {
-            for (int j = 0; j < Cols; ++j) {
-                data[i][j] = op(data[i][j], scalar);
-            }
-        }
-        return *this;
-    }
-
-    Matrix multiply(const Matrix& other) const {
-        static_assert(Cols == Rows, "Matrix multiplication requires matrix A's columns to match matrix B's rows.");
-        Matrix result;
-        for (int i = 0; i < Rows; ++i) {
-            for (int j = 0; j < other.Cols; ++j) {
-                result[i][j] = 0;
-                for (int k = 0; k < Cols; ++k) {
-                    result[i][j] += data[i][k] * other[k][j];
-                }
-            }
-        }
-        return result;
-    }
-};
-
-// Aliases
-template <typename T> using mat2x2 = Matrix<T, 2, 2>;
-template <typename T> using mat3x3 = Matrix<T, 3, 3>;
-template <typename T> using mat4x4 = Matrix<T, 4, 4>;
-template <typename T> using Mat2x2 = Matrix<T, 2, 2>;
-template <typename T> using Mat3x3 = Matrix<T, 3, 3>;
-template <typename T> using Mat4x4 = Matrix<T, 4, 4>;
-template <typename T> using mat2X2 = Matrix<T, 2, 2>;
-template <typename T> using mat3X3 = Matrix<T, 3, 3>;
-template <typename T> using mat4X4 = Matrix<T, 4, 4>;
-template <typename T> using Mat2X2 = Matrix<T, 2, 2>;
-template <typename T> using Mat3X3 = Matrix<T, 3, 3>;
-template <typename T> using Mat4X4 = Matrix<T, 4, 4>;
-template <typename T> using matrix2x2 = Matrix<T, 2, 2>;
-template <typename T> using matrix3x3 = Matrix<T, 3, 3>;
-template <typename T> using matrix4x4 = Matrix<T, 4, 4>;
-template <typename T> using Matrix2x2 = Matrix<T, 2, 2>;
-template <typename T> using Matrix3x3 = Matrix<T, 3, 3>;
-template <typename T> using Matrix4x4 = Matrix<T, 4, 4>;
-template <typename T> using matrix2X2 = Matrix<T, 2, 2>;
-template <typename T> using matrix3X3 = Matrix<T, 3, 3>;
-template <typename T> using matrix4X4 = Matrix<T, 4, 4>;
-template <typename T> using Matrix2X2 = Matrix<T, 2, 2>;
-template <typename T> using Matrix3X3 = Matrix<T, 3, 3>;
-template <typename T> using Matrix4X4 = Matrix<T, 4, 4>;
+#pragma once
+#include <iostream>
+#include <array>
+#include <algorithm>
+#include <type_traits>
+#include <cmath>
+#include <cassert>
+#include <span>
+#include "AlignedAllocator.hpp"
+#include "Gemm.hpp"
+#include "Instrumentation.hpp"
+#include "Parallel.hpp"
+#include "Simd.hpp"
+#include "Transpose.hpp"
+#include "MathUtils.hpp"
+#include "VectorBatch.hpp"
+#include "Expression.hpp"
+
+template <typename T, int N> class LU;
+template <typename T, int Rows, int Cols> class QR;
+template <typename T, int N> class Cholesky;
+
+// Rows x Cols matrix stored in Layout order (RowMajor or ColumnMajor, see MathUtils.hpp). Element (i, j) is
+// operator()(i, j) in either layout; operator[] returns a row and only exists for RowMajor.
+// Power-of-two sized matrices (e.g. float 4x4) are aligned to their size; see TINYMATH_MAX_ALIGNMENT
+template <typename T, int Rows, int Cols, typename Layout = RowMajor>
+class alignas(storage_alignment<T, Rows * Cols>()) Matrix {
+    static_assert(std::is_same_v<Layout, RowMajor> || std::is_same_v<Layout, ColumnMajor>, "Matrix layout must be RowMajor or ColumnMajor.");
+
+public:
+    static constexpr bool row_major = std::is_same_v<Layout, RowMajor>;
+    // Storage shape: data[outer][inner] holds rows for RowMajor and columns for ColumnMajor
+    static constexpr int outer_size = row_major ? Rows : Cols;
+    static constexpr int inner_size = row_major ? Cols : Rows;
+
+    std::array<std::array<T, inner_size>, outer_size> data{};
+
+    // Default constructor (initialize all elements to 0)
+    constexpr Matrix() = default;
+
+    // Constructor from initializer list
+    constexpr Matrix(std::initializer_list<std::initializer_list<T>> values) {
+        auto rowIt = values.begin();
+        for (int i = 0; i < Rows; ++i) {
+            auto colIt = rowIt->begin();
+            for (int j = 0; j < Cols; ++j) {
+                (*this)(i, j) = *colIt++;
+            }
+            ++rowIt;
+        }
+    }
+
+    // Conversion between layouts (a transposing copy of the storage)
+    template <typename OtherLayout> requires (!std::is_same_v<OtherLayout, Layout>)
+    constexpr explicit Matrix(const Matrix<T, Rows, Cols, OtherLayout>& other) {
+        for (int a = 0; a < outer_size; ++a) {
+            for (int b = 0; b < inner_size; ++b) {
+                data[a][b] = other.data[b][a];
+            }
+        }
+    }
+
+    // Evaluate a lazy element-wise expression (see Expression.hpp) in a single pass
+    template <typename E>
+    constexpr Matrix(const MatrixExpr<E>& expr) { assign(expr.self()); }
+    template <typename E>
+    constexpr Matrix& operator=(const MatrixExpr<E>& expr) { return assign(expr.self()); }
+
+    // Element-wise matrix operations
+    constexpr Matrix operator+(const Matrix& other) const { return apply(other, std::plus<>()); }
+    constexpr Matrix operator-(const Matrix& other) const { return apply(other, std::minus<>()); }
+    template <int K, typename OtherLayout>
+    constexpr Matrix<T, Rows, K, Layout> operator*(const Matrix<T, Cols, K, OtherLayout>& other) const { return multiply(other); }
+
+    constexpr Matrix& operator+=(const Matrix& other) { return apply_self(other, std::plus<>()); }
+    constexpr Matrix& operator-=(const Matrix& other) { return apply_self(other, std::minus<>()); }
+    constexpr Matrix& operator*=(const Matrix& other) {
+        static_assert(Cols == Rows, "In-place matrix multiplication requires a square matrix.");
+        return *this = multiply(other);
+    }
+
+    // Scalar operations
+    constexpr Matrix operator+(const T& scalar) const { return apply_scalar(scalar, std::plus<>()); }
+    constexpr Matrix operator-(const T& scalar) const { return apply_scalar(scalar, std::minus<>()); }
+    constexpr Matrix operator*(const T& scalar) const { return apply_scalar(scalar, std::multiplies<>()); }
+    constexpr Matrix operator/(const T& scalar) const { return apply_scalar(scalar, std::divides<>()); }
+
+    constexpr Matrix& operator+=(const T& scalar) { return apply_scalar_self(scalar, std::plus<>()); }
+    constexpr Matrix& operator-=(const T& scalar) { return apply_scalar_self(scalar, std::minus<>()); }
+    constexpr Matrix& operator*=(const T& scalar) { return apply_scalar_self(scalar, std::multiplies<>()); }
+    constexpr Matrix& operator/=(const T& scalar) { return apply_scalar_self(scalar, std::divides<>()); }
+
+    // Element access in either layout
+    constexpr T& operator()(int row, int col) {
+        if constexpr (row_major)
+            return data[row][col];
+        else
+            return data[col][row];
+    }
+    constexpr const T& operator()(int row, int col) const {
+        if constexpr (row_major)
+            return data[row][col];
+        else
+            return data[col][row];
+    }
+
+    // The Rows * Cols elements as one contiguous array in Layout order, e.g. for a column-major GPU upload or BLAS
+    // call (leading dimension inner_size). ptr() rather than data(), which is the storage member.
+    constexpr T* ptr() { return data[0].data(); }
+    constexpr const T* ptr() const { return data[0].data(); }
+
+    // Matrix utilities
+    // Transposes in either layout are a transpose of the storage; large ones use the blocked kernel (Transpose.hpp)
+    constexpr Matrix<T, Cols, Rows, Layout> transpose() const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixTranspose, 0);
+        Matrix<T, Cols, Rows, Layout> result;
+        if constexpr (Rows >= TINYMATH_TRANSPOSE_BLOCKED_MIN_DIM && Cols >= TINYMATH_TRANSPOSE_BLOCKED_MIN_DIM) {
+            if (!std::is_constant_evaluated()) {
+                transpose_blocked(outer_size, inner_size, ptr(), inner_size, result.ptr(), outer_size);
+                return result;
+            }
+        }
+        for (int a = 0; a < outer_size; ++a) {
+            for (int b = 0; b < inner_size; ++b) {
+                result.data[b][a] = data[a][b];
+            }
+        }
+        return result;
+    }
+
+    constexpr Matrix& transpose_inplace() {
+        static_assert(Rows == Cols, "In-place transpose requires a square matrix.");
+        TINYMATH_INSTRUMENT_SCOPE(MatrixTranspose, 0);
+        if constexpr (Rows >= TINYMATH_TRANSPOSE_BLOCKED_MIN_DIM) {
+            if (!std::is_constant_evaluated()) {
+                transpose_square_blocked(Rows, ptr(), Rows);
+                return *this;
+            }
+        }
+        // Small matrices fit in registers, where a full transposed copy beats element-wise swaps through memory
+        return *this = transpose();
+    }
+
+    // Determinant in closed form (cofactor expansion) for 2x2, 3x3 and 4x4 matrices.
+    // Works on the storage directly: for ColumnMajor that is the transpose, which has the same determinant.
+    constexpr T determinant() const {
+        static_assert(Rows == Cols && Rows >= 2 && Rows <= 4, "determinant() is only implemented for 2x2, 3x3 and 4x4 matrices.");
+        TINYMATH_INSTRUMENT_SCOPE(MatrixDeterminant, 2 * Rows * Rows * Rows / 3);
+        const auto& m = data;
+        if constexpr (Rows == 2) {
+            return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+        } else if constexpr (Rows == 3) {
+            return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+                 - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+                 + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+        } else {
+            T s[6], c[6];
+            minors4(s, c);
+            return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+        }
+    }
+
+    // Inverse as adjugate / determinant for 2x2, 3x3 and 4x4 matrices (SSE for float 4x4).
+    // The matrix must not be singular. Like determinant() it inverts the storage as if it were row-major, which is
+    // also correct for ColumnMajor: inverse(transpose(M)) == transpose(inverse(M)).
+    constexpr Matrix inverse() const {
+        static_assert(Rows == Cols && Rows >= 2 && Rows <= 4, "inverse() is only implemented for 2x2, 3x3 and 4x4 matrices.");
+        static_assert(std::is_floating_point_v<T>, "inverse() requires a floating-point element type.");
+        TINYMATH_INSTRUMENT_SCOPE(MatrixInverse, 2 * Rows * Rows * Rows);
+        Matrix r;
+        if constexpr (SimdInverseKernel<T, Rows>::enabled) {
+            if (!std::is_constant_evaluated()) {
+                [[maybe_unused]] const T det = SimdInverseKernel<T, Rows>::inverse(data[0].data(), r.data[0].data());
+                assert(det != 0 && "inverse() of a singular matrix");
+                return r;
+            }
+        }
+        const auto& m = data;
+        if constexpr (Rows == 2) {
+            const T det = determinant();
+            assert(det != 0 && "inverse() of a singular matrix");
+            const T inv = 1 / det;
+            r.data[0][0] = m[1][1] * inv;
+            r.data[0][1] = -m[0][1] * inv;
+            r.data[1][0] = -m[1][0] * inv;
+            r.data[1][1] = m[0][0] * inv;
+        } else if constexpr (Rows == 3) {
+            // Rows of the inverse are cofactors of the columns: r = adj(m) / det
+            const T c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+            const T c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+            const T c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+            const T det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+            assert(det != 0 && "inverse() of a singular matrix");
+            const T inv = 1 / det;
+            r.data[0][0] = c00 * inv;
+            r.data[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv;
+            r.data[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv;
+            r.data[1][0] = c01 * inv;
+            r.data[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv;
+            r.data[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv;
+            r.data[2][0] = c02 * inv;
+            r.data[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv;
+            r.data[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv;
+        } else {
+            // 2x2 minors of the top two rows (s) and bottom two rows (c) are shared by all sixteen cofactors
+            T s[6], c[6];
+            minors4(s, c);
+            const T det = s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+            assert(det != 0 && "inverse() of a singular matrix");
+            const T inv = 1 / det;
+            r.data[0][0] = (m[1][1] * c[5] - m[1][2] * c[4] + m[1][3] * c[3]) * inv;
+            r.data[0][1] = (-m[0][1] * c[5] + m[0][2] * c[4] - m[0][3] * c[3]) * inv;
+            r.data[0][2] = (m[3][1] * s[5] - m[3][2] * s[4] + m[3][3] * s[3]) * inv;
+            r.data[0][3] = (-m[2][1] * s[5] + m[2][2] * s[4] - m[2][3] * s[3]) * inv;
+            r.data[1][0] = (-m[1][0] * c[5] + m[1][2] * c[2] - m[1][3] * c[1]) * inv;
+            r.data[1][1] = (m[0][0] * c[5] - m[0][2] * c[2] + m[0][3] * c[1]) * inv;
+            r.data[1][2] = (-m[3][0] * s[5] + m[3][2] * s[2] - m[3][3] * s[1]) * inv;
+            r.data[1][3] = (m[2][0] * s[5] - m[2][2] * s[2] + m[2][3] * s[1]) * inv;
+            r.data[2][0] = (m[1][0] * c[4] - m[1][1] * c[2] + m[1][3] * c[0]) * inv;
+            r.data[2][1] = (-m[0][0] * c[4] + m[0][1] * c[2] - m[0][3] * c[0]) * inv;
+            r.data[2][2] = (m[3][0] * s[4] - m[3][1] * s[2] + m[3][3] * s[0]) * inv;
+            r.data[2][3] = (-m[2][0] * s[4] + m[2][1] * s[2] - m[2][3] * s[0]) * inv;
+            r.data[3][0] = (-m[1][0] * c[3] + m[1][1] * c[1] - m[1][2] * c[0]) * inv;
+            r.data[3][1] = (m[0][0] * c[3] - m[0][1] * c[1] + m[0][2] * c[0]) * inv;
+            r.data[3][2] = (-m[3][0] * s[3] + m[3][1] * s[1] - m[3][2] * s[0]) * inv;
+            r.data[3][3] = (m[2][0] * s[3] - m[2][1] * s[1] + m[2][2] * s[0]) * inv;
+        }
+        return r;
+    }
+
+    // Inverse of an affine transform [L t; 0 1] (3x3 in 2D, 4x4 in 3D) as [inv(L) -inv(L)t; 0 1].
+    // Only the linear block L is inverted; the bottom row is assumed to be (0, ..., 0, 1).
+    constexpr Matrix affine_inverse() const {
+        static_assert(Rows == Cols && (Rows == 3 || Rows == 4), "affine_inverse() requires a 3x3 or 4x4 matrix.");
+        constexpr int D = Rows - 1;
+        Matrix<T, D, D> linear;
+        for (int i = 0; i < D; ++i) {
+            for (int j = 0; j < D; ++j) {
+                linear[i][j] = (*this)(i, j);
+            }
+        }
+        return from_affine(linear.inverse());
+    }
+
+    // Inverse of a rigid transform (rotation and translation only): the rotation block is orthonormal,
+    // so its inverse is its transpose and no division is needed
+    constexpr Matrix rigid_inverse() const {
+        static_assert(Rows == Cols && (Rows == 3 || Rows == 4), "rigid_inverse() requires a 3x3 or 4x4 matrix.");
+        constexpr int D = Rows - 1;
+        Matrix<T, D, D> rotation;
+        for (int i = 0; i < D; ++i) {
+            for (int j = 0; j < D; ++j) {
+                rotation[i][j] = (*this)(j, i);
+            }
+        }
+        return from_affine(rotation);
+    }
+
+    // Factorizations with allocation-free solvers (see Decomposition.hpp); they work on a row-major copy
+    constexpr LU<T, Rows> lu() const {
+        static_assert(Rows == Cols, "LU decomposition requires a square matrix.");
+        return LU<T, Rows>(Matrix<T, Rows, Cols>(*this));
+    }
+    constexpr QR<T, Rows, Cols> qr() const { return QR<T, Rows, Cols>(Matrix<T, Rows, Cols>(*this)); }
+    constexpr Cholesky<T, Rows> cholesky() const {
+        static_assert(Rows == Cols, "Cholesky decomposition requires a square matrix.");
+        return Cholesky<T, Rows>(Matrix<T, Rows, Cols>(*this));
+    }
+
+    // Vector transformation (multiply matrix by vector); Policy picks the accumulation mode (see MathUtils.hpp)
+    template <typename Policy = DefaultAccumulation, typename U = T>
+    constexpr Vector<U, Rows> transform(const Vector<U, Cols>& vec) const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixTransform, 2 * Rows * Cols);
+        if constexpr (row_major) return storage_dot_rows<Policy>(vec);
+        else return storage_combine_rows<Policy>(vec);
+    }
+
+    // Matrix-vector product: (Rows x Cols) * Cols-vector, the same as transform(vec)
+    constexpr Vector<T, Rows> operator*(const Vector<T, Cols>& vec) const { return transform(vec); }
+
+    // transpose() * vec without materializing the transpose: the same storage walked the other way
+    template <typename Policy = DefaultAccumulation, typename U = T>
+    constexpr Vector<U, Cols> transpose_multiply(const Vector<U, Rows>& vec) const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixTransposeMultiply, 2 * Rows * Cols);
+        if constexpr (row_major) return storage_combine_rows<Policy>(vec);
+        else return storage_dot_rows<Policy>(vec);
+    }
+
+    // Matrix product with an explicit accumulation policy; operator* uses DefaultAccumulation.
+    // ExactAccumulation always runs the sequential i-j-k loop so results match the original implementation bit for bit.
+    // The result has this matrix's layout; an operand in the other layout is converted first. Two ColumnMajor
+    // operands multiply their storage (the transposes) in swapped order, since (AB)^T = B^T A^T.
+    template <typename Policy = DefaultAccumulation, int K, typename OtherLayout>
+    constexpr Matrix<T, Rows, K, Layout> multiply(const Matrix<T, Cols, K, OtherLayout>& other) const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixMultiply, 2 * Rows * Cols * K);
+        if constexpr (!std::is_same_v<OtherLayout, Layout>) {
+            return multiply<Policy>(Matrix<T, Cols, K, Layout>(other));
+        } else if constexpr (!row_major) {
+            Matrix<T, Rows, K, Layout> result;
+            result.data = other.storage().template multiply<Policy>(storage()).data;
+            return result;
+        } else {
+            return multiply_row_major<Policy>(other);
+        }
+    }
+
+    // Batched transformation: out[i] = transform(in[i]); out may be in itself, but must not otherwise overlap it.
+    // The matrix is loaded once per range, and large inputs are split across threads unless allow_threads is false.
+    void transform_batch(std::span<const Vector<T, Cols>> in, std::span<Vector<T, Rows>> out, bool allow_threads = true) const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixTransformBatch, 2.0 * Rows * Cols * in.size());
+        if constexpr (!row_major) {
+            // The packed-vector kernels read rows; one conversion per batch is negligible
+            Matrix<T, Rows, Cols>(*this).transform_batch(in, out, allow_threads);
+        } else {
+            assert(in.size() == out.size());
+            auto body = [&](size_t begin, size_t end) { transform_range(in.data() + begin, out.data() + begin, end - begin); };
+            if (allow_threads)
+                parallel_for(in.size(), TINYMATH_PARALLEL_MIN_BATCH, body);
+            else
+                body(0, in.size());
+        }
+    }
+
+    // Structure-of-arrays variant: each output lane is a linear combination of the input lanes; out may be in
+    void transform_batch(const VectorBatch<T, Cols>& in, VectorBatch<T, Rows>& out, bool allow_threads = true) const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixTransformBatch, 2.0 * Rows * Cols * in.size());
+        out.resize(in.size());
+        auto body = [&](size_t begin, size_t end) { transform_lanes(in, out, begin, end); };
+        if (allow_threads)
+            parallel_for(in.size(), TINYMATH_PARALLEL_MIN_BATCH, body);
+        else
+            body(0, in.size());
+    }
+
+    // Operators
+    constexpr bool operator==(const Matrix& other) const { return data == other.data; }
+    constexpr bool operator!=(const Matrix& other) const { return !(*this == other); }
+    constexpr std::array<T, Cols>& operator[](size_t index) requires row_major { return data[index]; }
+    constexpr const std::array<T, Cols>& operator[](size_t index) const requires row_major { return data[index]; }
+
+    void print() const {
+        for (size_t i = 0; i < Rows; ++i) {
+            std::cout << "[ ";
+            for (size_t j = 0; j < Cols; ++j) {
+                std::cout << (*this)(i, j) << (j < Cols - 1 ? ", " : "");
+            }
+            std::cout << " ]\n";
+        }
+    }
+
+private:
+    template <typename, int, int, typename> friend class Matrix;
+
+    template <typename E>
+    constexpr Matrix& assign(const E& expr) {
+        static_assert(E::rows == Rows && E::cols == Cols, "Matrix expression shape must match the destination shape.");
+        for (int i = 0; i < Rows; ++i) {
+            for (int j = 0; j < Cols; ++j) {
+                (*this)(i, j) = expr(i, j);
+            }
+        }
+        return *this;
+    }
+
+    // The storage as a row-major outer_size x inner_size matrix: this matrix for RowMajor, its transpose for ColumnMajor
+    constexpr Matrix<T, outer_size, inner_size> storage() const {
+        Matrix<T, outer_size, inner_size> result;
+        result.data = data;
+        return result;
+    }
+
+    template <typename Policy, int K>
+    constexpr Matrix<T, Rows, K> multiply_row_major(const Matrix<T, Cols, K>& other) const {
+        Matrix<T, Rows, K> result;
+
+        if constexpr (std::is_same_v<Policy, ExactAccumulation>) {
+            for (int i = 0; i < Rows; ++i) {
+                for (int j = 0; j < K; ++j) {
+                    result[i][j] = 0;
+                    for (int k = 0; k < Cols; ++k) {
+                        result[i][j] += data[i][k] * other[k][j];
+                    }
+                }
+            }
+            return result;
+        }
+        if constexpr (Rows >= TINYMATH_GEMM_BLOCKED_MIN_DIM && Cols >= TINYMATH_GEMM_BLOCKED_MIN_DIM && K >= TINYMATH_GEMM_BLOCKED_MIN_DIM) {
+            if (!std::is_constant_evaluated()) {
+                gemm(Rows, K, Cols, data[0].data(), Cols, 1, other.data[0].data(), K, 1, result.data[0].data(), K, 1);
+                return result;
+            }
+        }
+        // i-k-j order: each output row holds K independent multiply-add chains
+        for (int i = 0; i < Rows; ++i) {
+            for (int j = 0; j < K; ++j) {
+                result[i][j] = data[i][0] * other[0][j];
+            }
+            for (int k = 1; k < Cols; ++k) {
+                for (int j = 0; j < K; ++j) {
+                    result[i][j] = multiply_add<Policy>(data[i][k], other[k][j], result[i][j]);
+                }
+            }
+        }
+        return result;
+    }
+
+    template <typename Op>
+    constexpr Matrix apply(const Matrix& other, Op op) const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixElementwise, Rows * Cols);
+        Matrix result;
+        for (int i = 0; i < outer_size; ++i) {
+            for (int j = 0; j < inner_size; ++j) {
+                result.data[i][j] = op(data[i][j], other.data[i][j]);
+            }
+        }
+        return result;
+    }
+
+    template <typename Op>
+    constexpr Matrix& apply_self(const Matrix& other, Op op) {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixElementwise, Rows * Cols);
+        for (int i = 0; i < outer_size; ++i) {
+            for (int j = 0; j < inner_size; ++j) {
+                data[i][j] = op(data[i][j], other.data[i][j]);
+            }
+        }
+        return *this;
+    }
+
+    template <typename Op>
+    constexpr Matrix apply_scalar(const T& scalar, Op op) const {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixElementwise, Rows * Cols);
+        Matrix result;
+        for (int i = 0; i < outer_size; ++i) {
+            for (int j = 0; j < inner_size; ++j) {
+                result.data[i][j] = op(data[i][j], scalar);
+            }
+        }
+        return result;
+    }
+
+    template <typename Op>
+    constexpr Matrix& apply_scalar_self(const T& scalar, Op op) {
+        TINYMATH_INSTRUMENT_SCOPE(MatrixElementwise, Rows * Cols);
+        for (int i = 0; i < outer_size; ++i) {
+            for (int j = 0; j < inner_size; ++j) {
+                data[i][j] = op(data[i][j], scalar);
+            }
+        }
+        return *this;
+    }
+
+    // The six 2x2 minors of storage rows 0-1 (s) and 2-3 (c) of a 4x4 matrix
+    constexpr void minors4(T* s, T* c) const {
+        const auto& m = data;
+        s[0] = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+        s[1] = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+        s[2] = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+        s[3] = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+        s[4] = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+        s[5] = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+        c[0] = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+        c[1] = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+        c[2] = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+        c[3] = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+        c[4] = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+        c[5] = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+    }
+
+    // Builds [L -L t; 0 1] from an already inverted linear block L and this matrix's translation column t
+    template <int D>
+    constexpr Matrix from_affine(const Matrix<T, D, D>& inverse_linear) const {
+        Matrix r;
+        for (int i = 0; i < D; ++i) {
+            T t = 0;
+            for (int j = 0; j < D; ++j) {
+                r(i, j) = inverse_linear[i][j];
+                t -= inverse_linear[i][j] * (*this)(j, D);
+            }
+            r(i, D) = t;
+        }
+        r(D, D) = 1;
+        return r;
+    }
+
+    // Matrix-vector products on the storage: one dot product per stored row, or the stored rows scaled by the
+    // vector components and summed. transform and transpose_multiply pick one depending on the layout. The SIMD
+    // kernels reorder the sums, so ExactAccumulation stays on the sequential loops.
+    template <typename Policy, typename U>
+    constexpr Vector<U, outer_size> storage_dot_rows(const Vector<U, inner_size>& vec) const {
+        Vector<U, outer_size> result;
+        if constexpr (use_matvec_kernel<Policy, U>()) {
+            if (!std::is_constant_evaluated()) {
+                SimdMatVecKernel<T>::template dot_rows<Policy>(outer_size, inner_size, ptr(), inner_size, vec.data.data(), result.data.data());
+                return result;
+            }
+        }
+        for (int i = 0; i < outer_size; ++i) {
+            result[i] = dot_product<Policy, inner_size>(data[i].data(), vec.data.data());
+        }
+        return result;
+    }
+
+    template <typename Policy, typename U>
+    constexpr Vector<U, inner_size> storage_combine_rows(const Vector<U, outer_size>& vec) const {
+        Vector<U, inner_size> result;
+        if constexpr (use_matvec_kernel<Policy, U>()) {
+            if (!std::is_constant_evaluated()) {
+                SimdMatVecKernel<T>::template combine_rows<Policy>(outer_size, inner_size, ptr(), inner_size, vec.data.data(), result.data.data());
+                return result;
+            }
+        }
+        for (int j = 0; j < inner_size; ++j) {
+            result[j] = data[0][j] * vec[0];
+        }
+        for (int i = 1; i < outer_size; ++i) {
+            for (int j = 0; j < inner_size; ++j) {
+                result[j] = multiply_add<Policy>(data[i][j], vec[i], result[j]);
+            }
+        }
+        return result;
+    }
+
+    template <typename Policy, typename U>
+    static constexpr bool use_matvec_kernel() {
+        if constexpr (!SimdMatVecKernel<T>::enabled || !std::is_same_v<U, T> || std::is_same_v<Policy, ExactAccumulation>)
+            return false;
+        else
+            return inner_size >= SimdMatVecKernel<T>::width;
+    }
+
+    void transform_range(const Vector<T, Cols>* in, Vector<T, Rows>* out, size_t count) const {
+        if constexpr (SimdTransformKernel<T, Rows, Cols>::enabled) {
+            static_assert(sizeof(Vector<T, Cols>) == Cols * sizeof(T), "Vectors must be tightly packed.");
+            SimdTransformKernel<T, Rows, Cols>::template run<DefaultAccumulation>(data[0].data(), in[0].data.data(), out[0].data.data(), count);
+            return;
+        }
+        T m[Rows][Cols];
+        for (int i = 0; i < Rows; ++i) {
+            for (int j = 0; j < Cols; ++j) {
+                m[i][j] = data[i][j];
+            }
+        }
+        for (size_t n = 0; n < count; ++n) {
+            // Copied first, so out[n] may be in[n]
+            const Vector<T, Cols> v = in[n];
+            T* o = out[n].data.data();
+            for (int i = 0; i < Rows; ++i) {
+                o[i] = dot_product<DefaultAccumulation, Cols>(m[i], v.data.data());
+            }
+        }
+    }
+
+    // Walks the range in L1-sized blocks so every input lane block is reused for all Rows outputs. In place, each
+    // block is computed into a local buffer and stored after all rows are done, since row i overwrites input lane i.
+    void transform_lanes(const VectorBatch<T, Cols>& in, VectorBatch<T, Rows>& out, size_t begin, size_t end) const {
+        constexpr size_t Block = 512;
+        const bool in_place = static_cast<const void*>(&in) == static_cast<const void*>(&out);
+        alignas(64) T result[Rows][Block];
+        for (size_t base = begin; base < end; base += Block) {
+            const size_t count = std::min(Block, end - base);
+            for (int i = 0; i < Rows; ++i) {
+                T* o = in_place ? result[i] : out.lane(i) + base;
+                const T* v = in.lane(0) + base;
+                const T m0 = (*this)(i, 0);
+                for (size_t n = 0; n < count; ++n) {
+                    o[n] = m0 * v[n];
+                }
+                for (int j = 1; j < Cols; ++j) {
+                    const T mj = (*this)(i, j);
+                    v = in.lane(j) + base;
+                    for (size_t n = 0; n < count; ++n) {
+                        o[n] += mj * v[n];
+                    }
+                }
+            }
+            for (int i = 0; in_place && i < Rows; ++i) {
+                std::copy_n(result[i], count, out.lane(i) + base);
+            }
+        }
+    }
+};
+
+// Aliases
+template <typename T> using mat2x2 = Matrix<T, 2, 2>;
+template <typename T> using mat3x3 = Matrix<T, 3, 3>;
+template <typename T> using mat4x4 = Matrix<T, 4, 4>;
+template <typename T> using Mat2x2 = Matrix<T, 2, 2>;
+template <typename T> using Mat3x3 = Matrix<T, 3, 3>;
+template <typename T> using Mat4x4 = Matrix<T, 4, 4>;
+template <typename T> using mat2X2 = Matrix<T, 2, 2>;
+template <typename T> using mat3X3 = Matrix<T, 3, 3>;
+template <typename T> using mat4X4 = Matrix<T, 4, 4>;
+template <typename T> using Mat2X2 = Matrix<T, 2, 2>;
+template <typename T> using Mat3X3 = Matrix<T, 3, 3>;
+template <typename T> using Mat4X4 = Matrix<T, 4, 4>;
+template <typename T> using matrix2x2 = Matrix<T, 2, 2>;
+template <typename T> using matrix3x3 = Matrix<T, 3, 3>;
+template <typename T> using matrix4x4 = Matrix<T, 4, 4>;
+template <typename T> using Matrix2x2 = Matrix<T, 2, 2>;
+template <typename T> using Matrix3x3 = Matrix<T, 3, 3>;
+template <typename T> using Matrix4x4 = Matrix<T, 4, 4>;
+template <typename T> using matrix2X2 = Matrix<T, 2, 2>;
+template <typename T> using matrix3X3 = Matrix<T, 3, 3>;
+template <typename T> using matrix4X4 = Matrix<T, 4, 4>;
+template <typename T> using Matrix2X2 = Matrix<T, 2, 2>;
+template <typename T> using Matrix3X3 = Matrix<T, 3, 3>;
+template <typename T> using Matrix4X4 = Matrix<T, 4, 4>;
+
+// The factorization classes need the complete Matrix, so they are defined after it
+#include "Decomposition.hpp"
@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "AlignedAllocator.hpp"
+#include "Matrix.hpp"
+
+// Structure-of-arrays container for many Matrix<T, Rows, Cols>: element (i, j) of every matrix is stored contiguously
+// in lane(i, j) (64-byte aligned), so per-matrix algorithms written as loops over the batch run across matrices in
+// SIMD registers, the same way VectorBatch does for vectors.
+template <typename T, int Rows, int Cols>
+class MatrixBatch {
+public:
+    using Lane = AlignedArray<T>;
+
+    std::array<Lane, Rows * Cols> lanes{};
+
+    MatrixBatch() = default;
+    explicit MatrixBatch(size_t count) { resize(count); }
+    MatrixBatch(std::span<const Matrix<T, Rows, Cols>> matrices) {
+        resize(matrices.size());
+        for (size_t i = 0; i < matrices.size(); i++)
+            set(i, matrices[i]);
+    }
+
+    size_t size() const { return lanes[0].size(); }
+    void resize(size_t count) {
+        for (auto& lane : lanes)
+            lane.resize(count);
+    }
+
+    T* lane(int row, int col) { return lanes[row * Cols + col].data(); }
+    const T* lane(int row, int col) const { return lanes[row * Cols + col].data(); }
+
+    // Conversion to and from arrays of Matrix
+    Matrix<T, Rows, Cols> get(size_t index) const {
+        Matrix<T, Rows, Cols> result;
+        for (int i = 0; i < Rows; i++)
+            for (int j = 0; j < Cols; j++)
+                result[i][j] = lanes[i * Cols + j][index];
+        return result;
+    }
+
+    void set(size_t index, const Matrix<T, Rows, Cols>& mat) {
+        for (int i = 0; i < Rows; i++)
+            for (int j = 0; j < Cols; j++)
+                lanes[i * Cols + j][index] = mat[i][j];
+    }
+
+    void store(std::span<Matrix<T, Rows, Cols>> out) const {
+        assert(out.size() == size());
+        for (size_t i = 0; i < out.size(); i++)
+            out[i] = get(i);
+    }
+
+    std::vector<Matrix<T, Rows, Cols>> to_matrices() const {
+        std::vector<Matrix<T, Rows, Cols>> result(size());
+        store(result);
+        return result;
+    }
+};
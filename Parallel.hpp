@@ -0,0 +1,22 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include "ThreadPool.hpp"
+
+// Splits [0, count) into contiguous ranges and calls body(begin, end) for each, one range per pool thread.
+// Runs inline on the calling thread when there is not enough work for every thread to get min_chunk elements.
+template <typename F>
+void parallel_for(size_t count, size_t min_chunk, F&& body) {
+    ThreadPool& pool = ThreadPool::current();
+    const size_t chunks = std::min(pool.size(), count / std::max<size_t>(min_chunk, 1));
+    if (chunks <= 1) {
+        body(size_t(0), count);
+        return;
+    }
+
+    const size_t step = (count + chunks - 1) / chunks;
+    pool.run((count + step - 1) / step, [&](size_t chunk) {
+        const size_t begin = chunk * step;
+        body(begin, std::min(count, begin + step));
+    });
+}
@@ -0,0 +1,223 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+#include "Config.hpp"
+#include "Parallel.hpp"
+#include "Vector.hpp"
+#include "VectorBatch.hpp"
+
+// k-d tree over a fixed set of points for nearest-neighbor and radius queries. build() splits the points at the
+// median of their widest axis until at most PointIndexLeafSize remain, and stores them leaf by leaf in a
+// VectorBatch, so scanning a leaf is a straight loop over contiguous lanes that the compiler vectorizes across
+// points. Queries compare squared distances and never take a square root: they descend into the child on the
+// query's side of each split first, and skip the other child when its splitting plane is further away than the
+// current k-th nearest point or the radius.
+
+constexpr size_t PointIndexLeafSize = 16;
+
+template <typename T, int N>
+class PointIndex {
+public:
+    // A point found by a query: its position in the span the index was built from, and its squared distance
+    struct Neighbor {
+        size_t index;
+        T distance_squared;
+    };
+
+    PointIndex() = default;
+    explicit PointIndex(std::span<const Vector<T, N>> points) { build(points); }
+
+    // Replaces the indexed points; the index keeps its own copy
+    void build(std::span<const Vector<T, N>> points) {
+        nodes.clear();
+        std::vector<BuildPoint> work(points.size());
+        for (size_t i = 0; i < points.size(); ++i)
+            work[i] = { points[i], i };
+        if (!work.empty())
+            build_node(work, 0, work.size());
+        indices.resize(work.size());
+        sorted.resize(work.size());
+        for (size_t i = 0; i < work.size(); ++i) {
+            indices[i] = work[i].index;
+            sorted.set(i, work[i].point);
+        }
+    }
+
+    size_t size() const { return indices.size(); }
+    bool empty() const { return indices.empty(); }
+
+    // Nearest point; the index must not be empty
+    Neighbor nearest(const Vector<T, N>& query) const {
+        assert(!empty() && "Nearest point of an empty index.");
+        Neighbor best;
+        size_t found = 0;
+        search_nearest(0, query, &best, 1, found);
+        return best;
+    }
+
+    // The k nearest points, nearest first; all of them when the index holds fewer than k
+    std::vector<Neighbor> nearest(const Vector<T, N>& query, size_t k) const {
+        std::vector<Neighbor> result(std::min(k, size()));
+        size_t found = 0;
+        if (!result.empty())
+            search_nearest(0, query, result.data(), result.size(), found);
+        return result;
+    }
+
+    // Every point at most radius away, nearest first; radius must not be negative
+    std::vector<Neighbor> within_radius(const Vector<T, N>& query, T radius) const {
+        assert(radius >= 0 && "Negative search radius.");
+        std::vector<Neighbor> result;
+        if (!empty())
+            search_radius(0, query, radius * radius, result);
+        std::sort(result.begin(), result.end(), [](const Neighbor& a, const Neighbor& b) {
+            return a.distance_squared < b.distance_squared || (a.distance_squared == b.distance_squared && a.index < b.index);
+        });
+        return result;
+    }
+
+    // Batched queries, split across threads unless allow_threads is false. out[i * k + j] is the j-th nearest point
+    // to queries[i]; k must not exceed size().
+    void nearest_batch(std::span<const Vector<T, N>> queries, size_t k, std::span<Neighbor> out, bool allow_threads = true) const {
+        assert(k <= size());
+        assert(out.size() == queries.size() * k);
+        auto body = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                size_t found = 0;
+                if (k > 0)
+                    search_nearest(0, queries[i], out.data() + i * k, k, found);
+            }
+        };
+        if (allow_threads)
+            parallel_for(queries.size(), TINYMATH_PARALLEL_MIN_QUERIES, body);
+        else
+            body(0, queries.size());
+    }
+
+    std::vector<std::vector<Neighbor>> within_radius_batch(std::span<const Vector<T, N>> queries, T radius, bool allow_threads = true) const {
+        std::vector<std::vector<Neighbor>> result(queries.size());
+        auto body = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                result[i] = within_radius(queries[i], radius);
+        };
+        if (allow_threads)
+            parallel_for(queries.size(), TINYMATH_PARALLEL_MIN_QUERIES, body);
+        else
+            body(0, queries.size());
+        return result;
+    }
+
+private:
+    // Points of a node are sorted[begin, end). Leaves have axis -1; the left child of an inner node directly follows
+    // it and holds the points at or below split along axis, the right child the points at or above it.
+    struct Node {
+        size_t begin;
+        size_t end;
+        size_t right;
+        int axis;
+        T split;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<size_t> indices;   // original index of each point in sorted
+    VectorBatch<T, N> sorted;
+
+    // The points are partitioned together with their original indices, so the build reads them in order rather
+    // than through an index array
+    struct BuildPoint {
+        Vector<T, N> point;
+        size_t index;
+    };
+
+    size_t build_node(std::vector<BuildPoint>& work, size_t begin, size_t end) {
+        const size_t node = nodes.size();
+        nodes.push_back({ begin, end, 0, -1, T(0) });
+        if (end - begin <= PointIndexLeafSize)
+            return node;
+
+        Vector<T, N> low = work[begin].point;
+        Vector<T, N> high = low;
+        for (size_t i = begin + 1; i < end; ++i) {
+            for (int c = 0; c < N; ++c) {
+                low[c] = std::min(low[c], work[i].point[c]);
+                high[c] = std::max(high[c], work[i].point[c]);
+            }
+        }
+        int axis = 0;
+        for (int c = 1; c < N; ++c) {
+            if (high[c] - low[c] > high[axis] - low[axis])
+                axis = c;
+        }
+
+        const size_t middle = begin + (end - begin) / 2;
+        std::nth_element(work.begin() + begin, work.begin() + middle, work.begin() + end,
+            [axis](const BuildPoint& a, const BuildPoint& b) { return a.point[axis] < b.point[axis]; });
+        nodes[node].axis = axis;
+        nodes[node].split = work[middle].point[axis];
+        build_node(work, begin, middle);
+        const size_t right = build_node(work, middle, end);
+        nodes[node].right = right;
+        return node;
+    }
+
+    // Squared distances from query to every point of a leaf, component by component across the leaf's points
+    void leaf_distances(const Node& leaf, const Vector<T, N>& query, T* distances) const {
+        const size_t count = leaf.end - leaf.begin;
+        std::fill_n(distances, count, T(0));
+        for (int c = 0; c < N; ++c) {
+            const T* lane = sorted.lane(c) + leaf.begin;
+            const T q = query[c];
+            for (size_t i = 0; i < count; ++i) {
+                const T d = lane[i] - q;
+                distances[i] += d * d;
+            }
+        }
+    }
+
+    // best[0, found) holds the nearest points seen so far, nearest first, with at most k of them
+    void search_nearest(size_t index, const Vector<T, N>& query, Neighbor* best, size_t k, size_t& found) const {
+        const Node& node = nodes[index];
+        if (node.axis < 0) {
+            T distances[PointIndexLeafSize];
+            leaf_distances(node, query, distances);
+            for (size_t i = 0; i < node.end - node.begin; ++i) {
+                const T d = distances[i];
+                if (found == k && !(d < best[k - 1].distance_squared))
+                    continue;
+                size_t j = found < k ? found++ : k - 1;
+                for (; j > 0 && d < best[j - 1].distance_squared; --j)
+                    best[j] = best[j - 1];
+                best[j] = { indices[node.begin + i], d };
+            }
+            return;
+        }
+        const T offset = query[node.axis] - node.split;
+        const size_t near_child = offset < 0 ? index + 1 : node.right;
+        const size_t far_child = offset < 0 ? node.right : index + 1;
+        search_nearest(near_child, query, best, k, found);
+        if (found < k || offset * offset < best[k - 1].distance_squared)
+            search_nearest(far_child, query, best, k, found);
+    }
+
+    void search_radius(size_t index, const Vector<T, N>& query, T radius_squared, std::vector<Neighbor>& out) const {
+        const Node& node = nodes[index];
+        if (node.axis < 0) {
+            T distances[PointIndexLeafSize];
+            leaf_distances(node, query, distances);
+            for (size_t i = 0; i < node.end - node.begin; ++i) {
+                if (distances[i] <= radius_squared)
+                    out.push_back({ indices[node.begin + i], distances[i] });
+            }
+            return;
+        }
+        const T offset = query[node.axis] - node.split;
+        if (offset <= 0 || offset * offset <= radius_squared)
+            search_radius(index + 1, query, radius_squared, out);
+        if (offset >= 0 || offset * offset <= radius_squared)
+            search_radius(node.right, query, radius_squared, out);
+    }
+};
@@ -0,0 +1,181 @@
+#pragma once
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <span>
+#include <type_traits>
+#include "MathUtils.hpp"
+#include "Matrix.hpp"
+#include "Vector.hpp"
+#include "VectorBatch.hpp"
+
+// Rotation quaternion stored as a Vector<T, 4> in (x, y, z, w) order, w being the scalar part.
+// Rotations follow the same convention as Matrix::transform: to_matrix3().transform(v) == rotate(v).
+template <typename T>
+class Quaternion {
+    static_assert(std::is_floating_point_v<T>, "Quaternion requires a floating-point element type.");
+
+public:
+    Vector<T, 4> data{ 0, 0, 0, 1 };
+
+    // Identity rotation
+    constexpr Quaternion() = default;
+    constexpr Quaternion(T x, T y, T z, T w) : data{ x, y, z, w } {}
+    constexpr explicit Quaternion(const Vector<T, 4>& xyzw) : data(xyzw) {}
+
+    // Rotation by angle radians about axis (which must be unit length)
+    static Quaternion from_axis_angle(const Vector<T, 3>& axis, T angle) {
+        const T s = std::sin(angle / 2);
+        return Quaternion(axis[0] * s, axis[1] * s, axis[2] * s, std::cos(angle / 2));
+    }
+
+    // Rotation part of a pure rotation matrix (Shepperd's method: divides by the largest of the four candidates)
+    static constexpr Quaternion from_matrix(const Matrix<T, 3, 3>& m) {
+        const T trace = m[0][0] + m[1][1] + m[2][2];
+        if (trace > 0) {
+            const T s = math_sqrt(trace + 1) * 2;
+            return Quaternion((m[2][1] - m[1][2]) / s, (m[0][2] - m[2][0]) / s, (m[1][0] - m[0][1]) / s, s / 4);
+        }
+        if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+            const T s = math_sqrt(1 + m[0][0] - m[1][1] - m[2][2]) * 2;
+            return Quaternion(s / 4, (m[0][1] + m[1][0]) / s, (m[0][2] + m[2][0]) / s, (m[2][1] - m[1][2]) / s);
+        }
+        if (m[1][1] > m[2][2]) {
+            const T s = math_sqrt(1 + m[1][1] - m[0][0] - m[2][2]) * 2;
+            return Quaternion((m[0][1] + m[1][0]) / s, s / 4, (m[1][2] + m[2][1]) / s, (m[0][2] - m[2][0]) / s);
+        }
+        const T s = math_sqrt(1 + m[2][2] - m[0][0] - m[1][1]) * 2;
+        return Quaternion((m[0][2] + m[2][0]) / s, (m[1][2] + m[2][1]) / s, s / 4, (m[1][0] - m[0][1]) / s);
+    }
+
+    // Uses the upper-left 3x3 rotation block
+    static constexpr Quaternion from_matrix(const Matrix<T, 4, 4>& m) {
+        Matrix<T, 3, 3> r;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                r[i][j] = m[i][j];
+            }
+        }
+        return from_matrix(r);
+    }
+
+    constexpr T x() const { return data[0]; }
+    constexpr T y() const { return data[1]; }
+    constexpr T z() const { return data[2]; }
+    constexpr T w() const { return data[3]; }
+
+    // Hamilton product: (a * b) applies b first, then a
+    constexpr Quaternion operator*(const Quaternion& other) const {
+        const T ax = data[0], ay = data[1], az = data[2], aw = data[3];
+        const T bx = other.data[0], by = other.data[1], bz = other.data[2], bw = other.data[3];
+        return Quaternion(
+            aw * bx + ax * bw + ay * bz - az * by,
+            aw * by - ax * bz + ay * bw + az * bx,
+            aw * bz + ax * by - ay * bx + az * bw,
+            aw * bw - ax * bx - ay * by - az * bz);
+    }
+    constexpr Quaternion& operator*=(const Quaternion& other) { return *this = *this * other; }
+
+    // Component-wise arithmetic, as used for blending
+    constexpr Quaternion operator+(const Quaternion& other) const { return Quaternion(data + other.data); }
+    constexpr Quaternion operator-(const Quaternion& other) const { return Quaternion(data - other.data); }
+    constexpr Quaternion operator*(const T& scalar) const { return Quaternion(data * scalar); }
+    constexpr Quaternion operator-() const { return Quaternion(-data); }
+
+    // Quaternion utilities
+    constexpr T dot(const Quaternion& other) const { return data.dot(other.data); }
+    constexpr T magnitude() const { return data.magnitude(); }
+    constexpr Quaternion normalized() const { return Quaternion(data.normalized()); }
+    constexpr Quaternion& normalize() {
+        data.normalize();
+        return *this;
+    }
+    constexpr Quaternion conjugate() const { return Quaternion(-data[0], -data[1], -data[2], data[3]); }
+    constexpr Quaternion inverse() const {
+        const T norm = dot(*this);
+        assert(norm > 0 && "inverse() of a zero quaternion");
+        return Quaternion(conjugate().data / norm);
+    }
+
+    // Rotates v by this unit quaternion: v + w t + u x t with t = 2 (u x v), u the vector part.
+    // Written out in scalars so both cross products and t stay in registers, with no temporary Vectors in between.
+    constexpr Vector<T, 3> rotate(const Vector<T, 3>& v) const {
+        const T x = data[0], y = data[1], z = data[2], w = data[3];
+        const T tx = 2 * (y * v[2] - z * v[1]);
+        const T ty = 2 * (z * v[0] - x * v[2]);
+        const T tz = 2 * (x * v[1] - y * v[0]);
+        return Vector<T, 3>{
+            v[0] + w * tx + (y * tz - z * ty),
+            v[1] + w * ty + (z * tx - x * tz),
+            v[2] + w * tz + (x * ty - y * tx)
+        };
+    }
+
+    // Batched rotation: the quaternion is converted to a rotation matrix once (15 flops per vector instead of 30) and
+    // the batch runs through Matrix::transform_batch, which vectorizes across vectors and splits large inputs across threads.
+    // out may be in.
+    void rotate_batch(std::span<const Vector<T, 3>> in, std::span<Vector<T, 3>> out, bool allow_threads = true) const {
+        to_matrix3().transform_batch(in, out, allow_threads);
+    }
+
+    void rotate_batch(const VectorBatch<T, 3>& in, VectorBatch<T, 3>& out, bool allow_threads = true) const {
+        to_matrix3().transform_batch(in, out, allow_threads);
+    }
+
+    // Rotation matrices of this unit quaternion
+    constexpr Matrix<T, 3, 3> to_matrix3() const {
+        const T x = data[0], y = data[1], z = data[2], w = data[3];
+        const T xx = x * x, yy = y * y, zz = z * z;
+        const T xy = x * y, xz = x * z, yz = y * z;
+        const T wx = w * x, wy = w * y, wz = w * z;
+        return Matrix<T, 3, 3>{
+            { 1 - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy) },
+            { 2 * (xy + wz), 1 - 2 * (xx + zz), 2 * (yz - wx) },
+            { 2 * (xz - wy), 2 * (yz + wx), 1 - 2 * (xx + yy) }
+        };
+    }
+
+    constexpr Matrix<T, 4, 4> to_matrix4() const {
+        const Matrix<T, 3, 3> r = to_matrix3();
+        Matrix<T, 4, 4> result;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                result[i][j] = r[i][j];
+            }
+        }
+        result[3][3] = 1;
+        return result;
+    }
+
+    // Normalized linear interpolation along the shorter arc: cheap, but not constant angular velocity
+    static constexpr Quaternion nlerp(const Quaternion& start, const Quaternion& end, T t) {
+        const Quaternion target = start.dot(end) < 0 ? -end : end;
+        return Quaternion(Vector<T, 4>::lerp(start.data, target.data, t).normalized());
+    }
+
+    // Spherical linear interpolation along the shorter arc; falls back to nlerp for nearly parallel inputs
+    static Quaternion slerp(const Quaternion& start, const Quaternion& end, T t) {
+        T cosine = start.dot(end);
+        const Quaternion target = cosine < 0 ? -end : end;
+        cosine = std::abs(cosine);
+        if (cosine > T(0.9995))
+            return nlerp(start, target, t);
+        const T angle = std::acos(cosine);
+        const T inv_sin = 1 / std::sin(angle);
+        return start * (std::sin((1 - t) * angle) * inv_sin) + target * (std::sin(t * angle) * inv_sin);
+    }
+
+    // Operators
+    constexpr bool operator==(const Quaternion& other) const { return data == other.data; }
+    constexpr bool operator!=(const Quaternion& other) const { return !(*this == other); }
+    constexpr T& operator[](size_t index) { return data[index]; }
+    constexpr const T& operator[](size_t index) const { return data[index]; }
+
+    void print() const {
+        std::cout << "(" << data[0] << ", " << data[1] << ", " << data[2] << "; " << data[3] << ")\n";
+    }
+};
+
+// Aliases
+template <typename T> using quat = Quaternion<T>;
+template <typename T> using Quat = Quaternion<T>;
@@ -0,0 +1,238 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include "Config.hpp"
+#include "MathUtils.hpp"
+#include "Parallel.hpp"
+
+// Block kernels for the reductions over arrays of vectors (Vector::sum, mean, min, max, min_magnitude,
+// bounding_box), on N-component vectors stored back to back. The input is cut into blocks of about
+// ReductionBlockScalars scalars regardless of the thread count. One thread reduces each block into reduction_lanes()
+// independent accumulators that the compiler keeps in SIMD registers, and the block results are combined in a fixed
+// binary tree. The order of additions therefore depends only on the input size, so sums come out bit-identical with
+// and without threads.
+// The compensated sums rely on strict IEEE evaluation and do not survive -ffast-math.
+
+constexpr size_t ReductionStepBytes = 128;
+constexpr size_t ReductionBlockScalars = 4096;
+// Squared lengths computed side by side by min_magnitude; with fewer, GCC leaves the float4 and float2 loops scalar
+constexpr size_t ReductionMagnitudeStep = 32;
+
+// Accumulators per block: whole vectors and whole steps, so accumulator j always holds component j % N
+template <typename T, int N>
+constexpr size_t reduction_lanes() {
+    return std::lcm(N * sizeof(T), ReductionStepBytes) / sizeof(T);
+}
+
+// Vectors per block
+template <typename T, int N>
+constexpr size_t reduction_block_size() {
+    constexpr size_t lanes = reduction_lanes<T, N>();
+    return lanes / N * std::max<size_t>(1, ReductionBlockScalars / lanes);
+}
+
+// Identity of min: +infinity, or the largest value of types without one
+template <typename T>
+constexpr T reduction_highest() {
+    if constexpr (std::numeric_limits<T>::has_infinity)
+        return std::numeric_limits<T>::infinity();
+    else
+        return std::numeric_limits<T>::max();
+}
+
+template <typename T>
+constexpr T reduction_lowest() {
+    if constexpr (std::numeric_limits<T>::has_infinity)
+        return -std::numeric_limits<T>::infinity();
+    else
+        return std::numeric_limits<T>::lowest();
+}
+
+// sum + error == a + b exactly (Knuth's TwoSum)
+template <typename T>
+constexpr void two_sum(T a, T b, T& sum, T& error) {
+    sum = a + b;
+    const T b_rounded = sum - a;
+    error = (a - (sum - b_rounded)) + (b - b_rounded);
+}
+
+// Component sums of a block, with the rounding error still to be added when compensated
+template <typename T, int N>
+struct ReductionSum {
+    std::array<T, N> sum{};
+    std::array<T, N> error{};
+};
+
+template <typename Summation, typename T>
+constexpr bool compensated_summation() {
+    return std::is_same_v<Summation, KahanSummation> && std::is_floating_point_v<T>;
+}
+
+// sum + error += x + x_error
+template <typename Summation, typename T>
+constexpr void accumulate_sum(T& sum, T& error, T x, T x_error) {
+    if constexpr (compensated_summation<Summation, T>()) {
+        T rounding;
+        two_sum(sum, x, sum, rounding);
+        error += x_error + rounding;
+    } else {
+        sum += x;
+    }
+}
+
+template <typename Summation, typename T, int N>
+constexpr ReductionSum<T, N> combine_sums(ReductionSum<T, N> a, const ReductionSum<T, N>& b) {
+    for (int c = 0; c < N; ++c)
+        accumulate_sum<Summation>(a.sum[c], a.error[c], b.sum[c], b.error[c]);
+    return a;
+}
+
+template <typename Summation, typename T, int N>
+ReductionSum<T, N> sum_block(const T* data, size_t count) {
+    constexpr size_t lanes = reduction_lanes<T, N>();
+    T sum[lanes] = {};
+    T error[lanes] = {};
+    auto add = [&](size_t j, T x) {
+        if constexpr (compensated_summation<Summation, T>()) {
+            const T y = x + error[j];
+            const T t = sum[j] + y;
+            error[j] = y - (t - sum[j]);
+            sum[j] = t;
+        } else {
+            sum[j] += x;
+        }
+    };
+    const size_t scalars = count * N;
+    size_t i = 0;
+    for (; i + lanes <= scalars; i += lanes) {
+        for (size_t j = 0; j < lanes; ++j)
+            add(j, data[i + j]);
+    }
+    const size_t tail = scalars - i;
+    for (size_t j = 0; j < tail; ++j)
+        add(j, data[i + j]);
+
+    // Component by component: copying whole vectors out of the accumulators just stored from SIMD registers stalls
+    // on store forwarding, which cost more than the loop above on L1-resident blocks
+    ReductionSum<T, N> result;
+    for (size_t j = 0; j < lanes; j += N) {
+        for (int c = 0; c < N; ++c)
+            accumulate_sum<Summation>(result.sum[c], result.error[c], sum[j + c], error[j + c]);
+    }
+    return result;
+}
+
+// Component-wise minimum and maximum of a block; NaN components are skipped
+template <typename T, int N>
+struct ReductionBounds {
+    std::array<T, N> min;
+    std::array<T, N> max;
+};
+
+template <typename T, int N>
+constexpr ReductionBounds<T, N> combine_bounds(const ReductionBounds<T, N>& a, const ReductionBounds<T, N>& b) {
+    ReductionBounds<T, N> result;
+    for (int c = 0; c < N; ++c) {
+        result.min[c] = b.min[c] < a.min[c] ? b.min[c] : a.min[c];
+        result.max[c] = b.max[c] > a.max[c] ? b.max[c] : a.max[c];
+    }
+    return result;
+}
+
+// Only the requested sides are computed; the other one is left at its identity
+template <bool Min, bool Max, typename T, int N>
+ReductionBounds<T, N> bounds_block(const T* data, size_t count) {
+    constexpr size_t lanes = reduction_lanes<T, N>();
+    T low[lanes];
+    T high[lanes];
+    std::fill_n(low, lanes, reduction_highest<T>());
+    std::fill_n(high, lanes, reduction_lowest<T>());
+    auto add = [&](size_t j, T x) {
+        if constexpr (Min)
+            low[j] = x < low[j] ? x : low[j];
+        if constexpr (Max)
+            high[j] = x > high[j] ? x : high[j];
+    };
+    const size_t scalars = count * N;
+    size_t i = 0;
+    for (; i + lanes <= scalars; i += lanes) {
+        for (size_t j = 0; j < lanes; ++j)
+            add(j, data[i + j]);
+    }
+    const size_t tail = scalars - i;
+    for (size_t j = 0; j < tail; ++j)
+        add(j, data[i + j]);
+
+    ReductionBounds<T, N> result;
+    result.min.fill(reduction_highest<T>());
+    result.max.fill(reduction_lowest<T>());
+    for (size_t j = 0; j < lanes; j += N) {
+        for (int c = 0; c < N; ++c) {
+            result.min[c] = low[j + c] < result.min[c] ? low[j + c] : result.min[c];
+            result.max[c] = high[j + c] > result.max[c] ? high[j + c] : result.max[c];
+        }
+    }
+    return result;
+}
+
+// Smallest squared length in a block, each computed as sum += x * x in component order
+template <typename T, int N>
+T min_squared_block(const T* data, size_t count) {
+    constexpr size_t step = ReductionMagnitudeStep;
+    T best[step];
+    std::fill_n(best, step, reduction_highest<T>());
+    auto add = [&](size_t k, const T* v) {
+        T squared = 0;
+        for (int c = 0; c < N; ++c)
+            squared += v[c] * v[c];
+        best[k] = squared < best[k] ? squared : best[k];
+    };
+    size_t i = 0;
+    for (; i + step <= count; i += step) {
+        for (size_t k = 0; k < step; ++k)
+            add(k, data + (i + k) * N);
+    }
+    const size_t tail = count - i;
+    for (size_t k = 0; k < tail; ++k)
+        add(k, data + (i + k) * N);
+    return *std::min_element(best, best + step);
+}
+
+// Combines partials[0, count) as a balanced binary tree: the left half always takes count / 2 of them
+template <typename Partial, typename Combine>
+Partial reduce_tree(const Partial* partials, size_t count, Combine combine) {
+    if (count == 1)
+        return partials[0];
+    const size_t half = count / 2;
+    return combine(reduce_tree(partials, half, combine), reduce_tree(partials + half, count - half, combine));
+}
+
+// block(data, count) on every reduction_block_size() vectors of the count at data, split across threads unless
+// allow_threads is false, and the results combined by reduce_tree. Inputs of one block or less, including empty
+// ones, are reduced directly.
+template <typename T, int N, typename Block, typename Combine>
+auto reduce_blocks(const T* data, size_t count, bool allow_threads, Block block, Combine combine) {
+    using Partial = decltype(block(data, count));
+    constexpr size_t block_size = reduction_block_size<T, N>();
+    const size_t blocks = (count + block_size - 1) / block_size;
+    if (blocks <= 1)
+        return block(data, count);
+
+    std::vector<Partial> partials(blocks);
+    auto body = [&](size_t first, size_t last) {
+        for (size_t b = first; b < last; ++b) {
+            const size_t begin = b * block_size;
+            partials[b] = block(data + begin * N, std::min(block_size, count - begin));
+        }
+    };
+    if (allow_threads)
+        parallel_for(blocks, std::max<size_t>(1, TINYMATH_PARALLEL_MIN_BATCH / block_size), body);
+    else
+        body(0, blocks);
+    return reduce_tree(partials.data(), blocks, combine);
+}
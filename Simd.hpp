@@ -0,0 +1,797 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include "Config.hpp"
+#include "MathUtils.hpp"
+
+#ifdef TINYMATH_SIMD_SSE
+#include <immintrin.h>
+#endif
+
+// Explicit SIMD kernels for the hot Vector sizes.
+// SimdKernel<T, N>::enabled is false for every other type/size (and when TINYMATH_NO_SIMD is defined),
+// in which case Vector falls back to its generic element-wise loops. has_arithmetic covers the element-wise
+// operators and dot, which only pay off where a vector fills its registers.
+template <typename T, int N>
+struct SimdKernel {
+    static constexpr bool enabled = false;
+    static constexpr bool has_arithmetic = false;
+    static constexpr bool has_rsqrt = false;
+};
+
+// Explicit SIMD kernels for Matrix::transform_batch over contiguous arrays of vectors
+template <typename T, int Rows, int Cols>
+struct SimdTransformKernel {
+    static constexpr bool enabled = false;
+};
+
+// Explicit SIMD kernel for Matrix::inverse
+template <typename T, int N>
+struct SimdInverseKernel {
+    static constexpr bool enabled = false;
+};
+
+// Explicit SIMD kernel for Affine3 composition (3x4 row-major operands)
+template <typename T>
+struct SimdAffineKernel {
+    static constexpr bool enabled = false;
+};
+
+// Explicit SIMD tile kernel for the blocked transposes in Transpose.hpp
+template <typename T>
+struct SimdTransposeKernel {
+    static constexpr bool enabled = false;
+};
+
+// Explicit SIMD matrix-vector kernels for Matrix::transform / transpose_multiply and DynMatrix
+template <typename T>
+struct SimdMatVecKernel {
+    static constexpr bool enabled = false;
+};
+
+// Explicit SIMD kernels for Vector::normalize_batch over contiguous arrays of vectors
+template <typename T, int N>
+struct SimdNormalizeBatchKernel {
+    static constexpr bool enabled = false;
+};
+
+// Element-wise operators that have a SIMD equivalent
+template <typename Op>
+inline constexpr bool simd_supported_op = std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::minus<>> ||
+                                          std::is_same_v<Op, std::multiplies<>> || std::is_same_v<Op, std::divides<>>;
+
+// Positive, normal and finite: the squared lengths the reciprocal square root paths handle. The estimate instructions flush subnormals to
+// zero and a Newton-Raphson step on infinity gives NaN, so callers take the exact path for anything else.
+template <typename T>
+constexpr bool reciprocal_sqrt_domain(T x) {
+    return x >= std::numeric_limits<T>::min() && x <= std::numeric_limits<T>::max();
+}
+
+#ifdef TINYMATH_SIMD_SSE
+
+// Shared element-wise dispatch: maps the std functional object to the register operation of a kernel
+template <typename Kernel>
+struct SimdOps {
+    template <typename Op, typename Reg>
+    static Reg apply(Reg a, Reg b, Op) {
+        if constexpr (std::is_same_v<Op, std::plus<>>) return Kernel::add(a, b);
+        else if constexpr (std::is_same_v<Op, std::minus<>>) return Kernel::sub(a, b);
+        else if constexpr (std::is_same_v<Op, std::multiplies<>>) return Kernel::mul(a, b);
+        else return Kernel::div(a, b);
+    }
+
+    template <typename Op, typename T>
+    static void binary(const T* a, const T* b, T* out, Op op) {
+        auto rhs = std::is_same_v<Op, std::divides<>> ? Kernel::load_divisor(b) : Kernel::load(b);
+        Kernel::store(out, apply(Kernel::load(a), rhs, op));
+    }
+
+    template <typename Op, typename T>
+    static void scalar(const T* a, T s, T* out, Op op) {
+        Kernel::store(out, apply(Kernel::load(a), Kernel::broadcast(s), op));
+    }
+
+    template <typename T>
+    static T dot(const T* a, const T* b) {
+        return Kernel::hsum(Kernel::mul(Kernel::load(a), Kernel::load(b)));
+    }
+
+    // Normalizes in registers: one horizontal sum, one sqrt and one vector division, zero vectors pass through
+    template <typename T>
+    static void normalized(const T* a, T* out) {
+        auto v = Kernel::load(a);
+        auto mag = Kernel::sqrt(Kernel::hsum_broadcast(Kernel::mul(v, v)));
+        Kernel::store(out, Kernel::select_positive(mag, Kernel::div(v, mag), v));
+    }
+
+    // Reciprocal square root paths of magnitude and normalized (kernels with has_rsqrt): Kernel::rsqrt estimates
+    // 1 / sqrt, refined by one Newton-Raphson step for FastPrecision. Both return false, without writing, when the
+    // squared length is outside reciprocal_sqrt_domain.
+    template <typename Precision, typename T>
+    static bool magnitude_rsqrt(const T* a, T& out) {
+        auto v = Kernel::load(a);
+        auto squared = Kernel::hsum_broadcast(Kernel::mul(v, v));
+        if (!reciprocal_sqrt_domain(Kernel::first(squared)))
+            return false;
+        out = Kernel::first(divide_by_sqrt<Precision>(squared, squared));
+        return true;
+    }
+
+    template <typename Precision, typename T>
+    static bool normalized_rsqrt(const T* a, T* out) {
+        auto v = Kernel::load(a);
+        auto squared = Kernel::hsum_broadcast(Kernel::mul(v, v));
+        if (!reciprocal_sqrt_domain(Kernel::first(squared)))
+            return false;
+        Kernel::store(out, divide_by_sqrt<Precision>(v, squared));
+        return true;
+    }
+
+private:
+    // v * r, or v * r * (1.5 - 0.5 * x * r * r) with the Newton-Raphson step, where r estimates 1 / sqrt(x); v * r
+    // and 0.5 * x * r are formed alongside the step rather than after it
+    template <typename Precision, typename Reg>
+    static Reg divide_by_sqrt(Reg v, Reg x) {
+        const Reg r = Kernel::rsqrt(x);
+        if constexpr (std::is_same_v<Precision, FastPrecision>) {
+            const Reg half_x_r = Kernel::mul(Kernel::mul(Kernel::broadcast(0.5f), x), r);
+            return Kernel::mul(Kernel::mul(v, r), Kernel::sub(Kernel::broadcast(1.5f), Kernel::mul(half_x_r, r)));
+        } else {
+            return Kernel::mul(v, r);
+        }
+    }
+};
+
+// 4 x float in one SSE register
+template <>
+struct SimdKernel<float, 4> : SimdOps<SimdKernel<float, 4>> {
+    static constexpr bool enabled = true;
+    static constexpr bool has_arithmetic = true;
+    static constexpr bool has_rsqrt = true;
+    using Reg = __m128;
+
+    static Reg load(const float* p) { return _mm_loadu_ps(p); }
+    static Reg load_divisor(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, Reg v) { _mm_storeu_ps(p, v); }
+    static Reg broadcast(float s) { return _mm_set1_ps(s); }
+
+    static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm_div_ps(a, b); }
+    static Reg sqrt(Reg a) { return _mm_sqrt_ps(a); }
+    static Reg rsqrt(Reg a) { return _mm_rsqrt_ps(a); }
+    static float first(Reg v) { return _mm_cvtss_f32(v); }
+
+    static Reg hsum_broadcast(Reg v) {
+        Reg s = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+    static float hsum(Reg v) { return _mm_cvtss_f32(hsum_broadcast(v)); }
+    // out[k] = horizontal sum of the k-th register
+    static void store_hsum4(float* out, Reg a, Reg b, Reg c, Reg d) {
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        _mm_storeu_ps(out, _mm_add_ps(_mm_add_ps(a, b), _mm_add_ps(c, d)));
+    }
+
+    static Reg select_positive(Reg cond, Reg a, Reg b) {
+        Reg mask = _mm_cmpgt_ps(cond, _mm_setzero_ps());
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+};
+
+// 3 x float padded to a full SSE register for normalized and the reciprocal square root paths; the unused lane is 0
+// and never stored. The element-wise operators, dot and cross stay on the generic loops: moving three floats in and
+// out of a register costs more than the one instruction saved, and the scalar loops vectorize across the elements
+// of an array instead.
+template <>
+struct SimdKernel<float, 3> : SimdOps<SimdKernel<float, 3>> {
+    static constexpr bool enabled = true;
+    static constexpr bool has_arithmetic = false;
+    static constexpr bool has_rsqrt = true;
+    using Reg = __m128;
+
+    // One 8-byte and one 4-byte load joined by a shuffle, rather than a chain of inserts
+    static Reg load(const float* p) {
+        return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p))), _mm_load_ss(p + 2));
+    }
+    static void store(float* p, Reg v) {
+        _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+    }
+    static Reg broadcast(float s) { return _mm_set1_ps(s); }
+
+    static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm_div_ps(a, b); }
+    static Reg sqrt(Reg a) { return _mm_sqrt_ps(a); }
+    static Reg rsqrt(Reg a) { return _mm_rsqrt_ps(a); }
+    static float first(Reg v) { return _mm_cvtss_f32(v); }
+
+    static Reg hsum_broadcast(Reg v) { return SimdKernel<float, 4>::hsum_broadcast(v); }
+    static Reg select_positive(Reg cond, Reg a, Reg b) { return SimdKernel<float, 4>::select_positive(cond, a, b); }
+};
+
+#ifdef TINYMATH_SIMD_AVX
+// 4 x double in one AVX register
+template <>
+struct SimdKernel<double, 4> : SimdOps<SimdKernel<double, 4>> {
+    static constexpr bool enabled = true;
+    static constexpr bool has_arithmetic = true;
+    static constexpr bool has_rsqrt = false;
+    using Reg = __m256d;
+
+    static Reg load(const double* p) { return _mm256_loadu_pd(p); }
+    static Reg load_divisor(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, Reg v) { _mm256_storeu_pd(p, v); }
+    static Reg broadcast(double s) { return _mm256_set1_pd(s); }
+
+    static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm256_sub_pd(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm256_div_pd(a, b); }
+    static Reg sqrt(Reg a) { return _mm256_sqrt_pd(a); }
+
+    static Reg hsum_broadcast(Reg v) {
+        Reg s = _mm256_add_pd(v, _mm256_permute2f128_pd(v, v, 1));
+        return _mm256_add_pd(s, _mm256_permute_pd(s, 0b0101));
+    }
+    static double hsum(Reg v) { return _mm256_cvtsd_f64(hsum_broadcast(v)); }
+    // out[k] = horizontal sum of the k-th register
+    static void store_hsum4(double* out, Reg a, Reg b, Reg c, Reg d) {
+        Reg ab = _mm256_hadd_pd(a, b), cd = _mm256_hadd_pd(c, d);
+        _mm256_storeu_pd(out, _mm256_add_pd(_mm256_permute2f128_pd(ab, cd, 0x20), _mm256_permute2f128_pd(ab, cd, 0x31)));
+    }
+
+    static Reg select_positive(Reg cond, Reg a, Reg b) {
+        return _mm256_blendv_pd(b, a, _mm256_cmp_pd(cond, _mm256_setzero_pd(), _CMP_GT_OQ));
+    }
+};
+#else
+// 4 x double as a pair of SSE2 registers
+struct SimdDouble4 {
+    __m128d lo, hi;
+};
+
+template <>
+struct SimdKernel<double, 4> : SimdOps<SimdKernel<double, 4>> {
+    static constexpr bool enabled = true;
+    static constexpr bool has_arithmetic = true;
+    static constexpr bool has_rsqrt = false;
+    using Reg = SimdDouble4;
+
+    static Reg load(const double* p) { return { _mm_loadu_pd(p), _mm_loadu_pd(p + 2) }; }
+    static Reg load_divisor(const double* p) { return load(p); }
+    static void store(double* p, Reg v) { _mm_storeu_pd(p, v.lo); _mm_storeu_pd(p + 2, v.hi); }
+    static Reg broadcast(double s) { return { _mm_set1_pd(s), _mm_set1_pd(s) }; }
+
+    static Reg add(Reg a, Reg b) { return { _mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi) }; }
+    static Reg sub(Reg a, Reg b) { return { _mm_sub_pd(a.lo, b.lo), _mm_sub_pd(a.hi, b.hi) }; }
+    static Reg mul(Reg a, Reg b) { return { _mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi) }; }
+    static Reg div(Reg a, Reg b) { return { _mm_div_pd(a.lo, b.lo), _mm_div_pd(a.hi, b.hi) }; }
+    static Reg sqrt(Reg a) { return { _mm_sqrt_pd(a.lo), _mm_sqrt_pd(a.hi) }; }
+
+    static Reg hsum_broadcast(Reg v) {
+        __m128d s = _mm_add_pd(v.lo, v.hi);
+        s = _mm_add_pd(s, _mm_shuffle_pd(s, s, 1));
+        return { s, s };
+    }
+    static double hsum(Reg v) { return _mm_cvtsd_f64(hsum_broadcast(v).lo); }
+
+    static Reg select_positive(Reg cond, Reg a, Reg b) {
+        __m128d zero = _mm_setzero_pd();
+        __m128d mlo = _mm_cmpgt_pd(cond.lo, zero), mhi = _mm_cmpgt_pd(cond.hi, zero);
+        return { _mm_or_pd(_mm_and_pd(mlo, a.lo), _mm_andnot_pd(mlo, b.lo)),
+                 _mm_or_pd(_mm_and_pd(mhi, a.hi), _mm_andnot_pd(mhi, b.hi)) };
+    }
+};
+#endif // TINYMATH_SIMD_AVX
+
+// Register-wide multiply_add (see MathUtils.hpp): fused only for FusedAccumulation with TINYMATH_FMA
+template <typename Policy>
+inline __m128 simd_multiply_add(__m128 a, __m128 b, __m128 c) {
+#ifdef TINYMATH_FMA
+    if constexpr (std::is_same_v<Policy, FusedAccumulation>)
+        return _mm_fmadd_ps(a, b, c);
+#endif
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+#ifdef TINYMATH_SIMD_AVX
+template <typename Policy>
+inline __m256d simd_multiply_add(__m256d a, __m256d b, __m256d c) {
+#ifdef TINYMATH_FMA
+    if constexpr (std::is_same_v<Policy, FusedAccumulation>)
+        return _mm256_fmadd_pd(a, b, c);
+#endif
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+}
+
+template <typename Policy>
+inline __m256 simd_multiply_add(__m256 a, __m256 b, __m256 c) {
+#ifdef TINYMATH_FMA
+    if constexpr (std::is_same_v<Policy, FusedAccumulation>)
+        return _mm256_fmadd_ps(a, b, c);
+#endif
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+}
+
+// 8 x float in one AVX register; only the matrix-vector kernels below use it, Vector stops at 4 lanes
+struct SimdFloat8 {
+    using Reg = __m256;
+
+    static Reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, Reg v) { _mm256_storeu_ps(p, v); }
+    static Reg broadcast(float s) { return _mm256_set1_ps(s); }
+    static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+
+    static float hsum(Reg v) {
+        return SimdKernel<float, 4>::hsum(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+    }
+    // out[k] = horizontal sum of the k-th register: two rounds of hadd leave the sums of each 128-bit half
+    static void store_hsum4(float* out, Reg a, Reg b, Reg c, Reg d) {
+        const Reg sums = _mm256_hadd_ps(_mm256_hadd_ps(a, b), _mm256_hadd_ps(c, d));
+        _mm_storeu_ps(out, _mm_add_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1)));
+    }
+};
+#endif // TINYMATH_SIMD_AVX
+
+// Matrix-vector products on row-strided storage over Width-lane registers (AVX float and double, SSE float).
+// Callers need at least Width columns; the remaining columns are finished in scalar code.
+template <typename Kernel, int Width>
+struct SimdMatVecOps {
+    static constexpr int width = Width;
+
+    // y[i] = dot(row i, x) for rows x cols storage; four rows at a time keep four independent accumulators that
+    // are reduced together by one store_hsum4
+    template <typename Policy, typename T>
+    static void dot_rows(int rows, int cols, const T* m, std::ptrdiff_t stride, const T* x, T* y) {
+        const int vector_cols = cols - cols % Width;
+        int i = 0;
+        for (; i + 4 <= rows; i += 4) {
+            const T* r0 = m + i * stride;
+            const T* r1 = r0 + stride;
+            const T* r2 = r1 + stride;
+            const T* r3 = r2 + stride;
+            auto xv = Kernel::load(x);
+            auto a0 = Kernel::mul(Kernel::load(r0), xv), a1 = Kernel::mul(Kernel::load(r1), xv);
+            auto a2 = Kernel::mul(Kernel::load(r2), xv), a3 = Kernel::mul(Kernel::load(r3), xv);
+            for (int j = Width; j < vector_cols; j += Width) {
+                xv = Kernel::load(x + j);
+                a0 = simd_multiply_add<Policy>(Kernel::load(r0 + j), xv, a0);
+                a1 = simd_multiply_add<Policy>(Kernel::load(r1 + j), xv, a1);
+                a2 = simd_multiply_add<Policy>(Kernel::load(r2 + j), xv, a2);
+                a3 = simd_multiply_add<Policy>(Kernel::load(r3 + j), xv, a3);
+            }
+            Kernel::store_hsum4(y + i, a0, a1, a2, a3);
+            for (int j = vector_cols; j < cols; ++j) {
+                y[i] = multiply_add<Policy>(r0[j], x[j], y[i]);
+                y[i + 1] = multiply_add<Policy>(r1[j], x[j], y[i + 1]);
+                y[i + 2] = multiply_add<Policy>(r2[j], x[j], y[i + 2]);
+                y[i + 3] = multiply_add<Policy>(r3[j], x[j], y[i + 3]);
+            }
+        }
+        for (; i < rows; ++i) {
+            const T* r = m + i * stride;
+            auto a = Kernel::mul(Kernel::load(r), Kernel::load(x));
+            for (int j = Width; j < vector_cols; j += Width)
+                a = simd_multiply_add<Policy>(Kernel::load(r + j), Kernel::load(x + j), a);
+            T sum = Kernel::hsum(a);
+            for (int j = vector_cols; j < cols; ++j)
+                sum = multiply_add<Policy>(r[j], x[j], sum);
+            y[i] = sum;
+        }
+    }
+
+    // y = sum over i of x[i] * row i for rows x cols storage (the transposed product). Each pass down the rows
+    // reads four registers of every row contiguously into four independent accumulators.
+    template <typename Policy, typename T>
+    static void combine_rows(int rows, int cols, const T* m, std::ptrdiff_t stride, const T* x, T* y) {
+        const int vector_cols = cols - cols % Width;
+        int j = 0;
+        if (vector_cols > 4 * Width && rows >= 16) {
+            const auto x0 = Kernel::broadcast(x[0]);
+            for (int jj = 0; jj < vector_cols; jj += Width)
+                Kernel::store(y + jj, Kernel::mul(x0, Kernel::load(m + jj)));
+            for (int i = 1; i < rows; ++i) {
+                const T* r = m + i * stride;
+                const auto xi = Kernel::broadcast(x[i]);
+                for (int jj = 0; jj < vector_cols; jj += Width)
+                    Kernel::store(y + jj, simd_multiply_add<Policy>(xi, Kernel::load(r + jj), Kernel::load(y + jj)));
+            }
+            j = vector_cols;
+        }
+        for (; j + 4 * Width <= vector_cols; j += 4 * Width) {
+            const T* r = m + j;
+            auto xi = Kernel::broadcast(x[0]);
+            auto a0 = Kernel::mul(xi, Kernel::load(r)), a1 = Kernel::mul(xi, Kernel::load(r + Width));
+            auto a2 = Kernel::mul(xi, Kernel::load(r + 2 * Width)), a3 = Kernel::mul(xi, Kernel::load(r + 3 * Width));
+            for (int i = 1; i < rows; ++i) {
+                r += stride;
+                xi = Kernel::broadcast(x[i]);
+                a0 = simd_multiply_add<Policy>(xi, Kernel::load(r), a0);
+                a1 = simd_multiply_add<Policy>(xi, Kernel::load(r + Width), a1);
+                a2 = simd_multiply_add<Policy>(xi, Kernel::load(r + 2 * Width), a2);
+                a3 = simd_multiply_add<Policy>(xi, Kernel::load(r + 3 * Width), a3);
+            }
+            Kernel::store(y + j, a0);
+            Kernel::store(y + j + Width, a1);
+            Kernel::store(y + j + 2 * Width, a2);
+            Kernel::store(y + j + 3 * Width, a3);
+        }
+        // Remaining single registers split the rows over four accumulators so tall matrices are not one long
+        // dependency chain
+        for (; j < vector_cols; j += Width) {
+            const T* r = m + j;
+            auto a0 = Kernel::mul(Kernel::broadcast(x[0]), Kernel::load(r));
+            auto a1 = Kernel::broadcast(T(0)), a2 = a1, a3 = a1;
+            int i = 1;
+            for (; i + 4 <= rows; i += 4) {
+                a1 = simd_multiply_add<Policy>(Kernel::broadcast(x[i]), Kernel::load(r + i * stride), a1);
+                a2 = simd_multiply_add<Policy>(Kernel::broadcast(x[i + 1]), Kernel::load(r + (i + 1) * stride), a2);
+                a3 = simd_multiply_add<Policy>(Kernel::broadcast(x[i + 2]), Kernel::load(r + (i + 2) * stride), a3);
+                a0 = simd_multiply_add<Policy>(Kernel::broadcast(x[i + 3]), Kernel::load(r + (i + 3) * stride), a0);
+            }
+            for (; i < rows; ++i)
+                a0 = simd_multiply_add<Policy>(Kernel::broadcast(x[i]), Kernel::load(r + i * stride), a0);
+            Kernel::store(y + j, Kernel::add(Kernel::add(a0, a1), Kernel::add(a2, a3)));
+        }
+        for (; j < cols; ++j) {
+            T sum = m[j] * x[0];
+            for (int i = 1; i < rows; ++i)
+                sum = multiply_add<Policy>(m[i * stride + j], x[i], sum);
+            y[j] = sum;
+        }
+    }
+};
+
+#ifdef TINYMATH_SIMD_AVX
+template <>
+struct SimdMatVecKernel<float> : SimdMatVecOps<SimdFloat8, 8> {
+    static constexpr bool enabled = true;
+};
+
+template <>
+struct SimdMatVecKernel<double> : SimdMatVecOps<SimdKernel<double, 4>, 4> {
+    static constexpr bool enabled = true;
+};
+#else
+template <>
+struct SimdMatVecKernel<float> : SimdMatVecOps<SimdKernel<float, 4>, 4> {
+    static constexpr bool enabled = true;
+};
+#endif // TINYMATH_SIMD_AVX
+
+// 4x4 float matrix times packed 4-float vectors: the four matrix columns stay in registers for the whole batch and
+// each output is the sum of the columns scaled by the broadcast input components
+template <>
+struct SimdTransformKernel<float, 4, 4> {
+    static constexpr bool enabled = true;
+
+    template <typename Policy>
+    static void run(const float* m, const float* in, float* out, size_t count) {
+        const __m128 c0 = _mm_setr_ps(m[0], m[4], m[8], m[12]);
+        const __m128 c1 = _mm_setr_ps(m[1], m[5], m[9], m[13]);
+        const __m128 c2 = _mm_setr_ps(m[2], m[6], m[10], m[14]);
+        const __m128 c3 = _mm_setr_ps(m[3], m[7], m[11], m[15]);
+        for (size_t i = 0; i < count; i++, in += 4, out += 4) {
+            const __m128 v = _mm_loadu_ps(in);
+            __m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+            r = simd_multiply_add<Policy>(c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+            r = simd_multiply_add<Policy>(c2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+            r = simd_multiply_add<Policy>(c3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+            _mm_storeu_ps(out, r);
+        }
+    }
+};
+
+// Affine composition a * b with 4-float rows: each output row is (0, 0, 0, a_i3) plus the rows of b scaled by the
+// broadcast a_i0..a_i2, so the implicit bottom row of b never has to be materialized
+template <>
+struct SimdAffineKernel<float> {
+    static constexpr bool enabled = true;
+
+    template <typename Policy>
+    static void compose(const float* a, const float* b, float* out) {
+        const __m128 b0 = _mm_loadu_ps(b);
+        const __m128 b1 = _mm_loadu_ps(b + 4);
+        const __m128 b2 = _mm_loadu_ps(b + 8);
+        const __m128 translation_mask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+        for (int i = 0; i < 3; i++, a += 4, out += 4) {
+            const __m128 row = _mm_loadu_ps(a);
+            __m128 r = _mm_and_ps(row, translation_mask);
+            r = simd_multiply_add<Policy>(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0, r);
+            r = simd_multiply_add<Policy>(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1, r);
+            r = simd_multiply_add<Policy>(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2, r);
+            _mm_storeu_ps(out, r);
+        }
+    }
+};
+
+#ifdef TINYMATH_SIMD_AVX
+// Same scheme with one 4-double row per AVX register
+template <>
+struct SimdAffineKernel<double> {
+    static constexpr bool enabled = true;
+
+    template <typename Policy>
+    static void compose(const double* a, const double* b, double* out) {
+        const __m256d b0 = _mm256_loadu_pd(b);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+        const __m256d b2 = _mm256_loadu_pd(b + 8);
+        for (int i = 0; i < 3; i++, a += 4, out += 4) {
+            __m256d r = _mm256_setr_pd(0, 0, 0, a[3]);
+            r = simd_multiply_add<Policy>(_mm256_broadcast_sd(a), b0, r);
+            r = simd_multiply_add<Policy>(_mm256_broadcast_sd(a + 1), b1, r);
+            r = simd_multiply_add<Policy>(_mm256_broadcast_sd(a + 2), b2, r);
+            _mm256_storeu_pd(out, r);
+        }
+    }
+};
+#endif // TINYMATH_SIMD_AVX
+
+// 4x4 float tiles through _MM_TRANSPOSE4_PS. Every tile is loaded before anything is stored, so the source and
+// destination may be the same tile (diagonal tiles of an in-place transpose).
+template <>
+struct SimdTransposeKernel<float> {
+    static constexpr bool enabled = true;
+    static constexpr int tile = 4;
+
+    static void transpose(const float* src, std::ptrdiff_t src_stride, float* dst, std::ptrdiff_t dst_stride) {
+        __m128 r0 = _mm_loadu_ps(src);
+        __m128 r1 = _mm_loadu_ps(src + src_stride);
+        __m128 r2 = _mm_loadu_ps(src + 2 * src_stride);
+        __m128 r3 = _mm_loadu_ps(src + 3 * src_stride);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(dst, r0);
+        _mm_storeu_ps(dst + dst_stride, r1);
+        _mm_storeu_ps(dst + 2 * dst_stride, r2);
+        _mm_storeu_ps(dst + 3 * dst_stride, r3);
+    }
+
+    // Exchanges tile a with the transpose of tile b (the mirrored off-diagonal pair of an in-place transpose)
+    static void swap_transpose(float* a, std::ptrdiff_t a_stride, float* b, std::ptrdiff_t b_stride) {
+        __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + a_stride), a2 = _mm_loadu_ps(a + 2 * a_stride), a3 = _mm_loadu_ps(a + 3 * a_stride);
+        __m128 b0 = _mm_loadu_ps(b), b1 = _mm_loadu_ps(b + b_stride), b2 = _mm_loadu_ps(b + 2 * b_stride), b3 = _mm_loadu_ps(b + 3 * b_stride);
+        _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+        _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+        _mm_storeu_ps(a, b0);
+        _mm_storeu_ps(a + a_stride, b1);
+        _mm_storeu_ps(a + 2 * a_stride, b2);
+        _mm_storeu_ps(a + 3 * a_stride, b3);
+        _mm_storeu_ps(b, a0);
+        _mm_storeu_ps(b + b_stride, a1);
+        _mm_storeu_ps(b + 2 * b_stride, a2);
+        _mm_storeu_ps(b + 3 * b_stride, a3);
+    }
+};
+
+#ifdef TINYMATH_SIMD_AVX
+// 4x4 double tiles: 2x2 transposes within each 128-bit half, then an exchange of the off-diagonal halves
+template <>
+struct SimdTransposeKernel<double> {
+    static constexpr bool enabled = true;
+    static constexpr int tile = 4;
+
+    static void transpose(const double* src, std::ptrdiff_t src_stride, double* dst, std::ptrdiff_t dst_stride) {
+        __m256d r0 = _mm256_loadu_pd(src);
+        __m256d r1 = _mm256_loadu_pd(src + src_stride);
+        __m256d r2 = _mm256_loadu_pd(src + 2 * src_stride);
+        __m256d r3 = _mm256_loadu_pd(src + 3 * src_stride);
+        transpose4(r0, r1, r2, r3);
+        _mm256_storeu_pd(dst, r0);
+        _mm256_storeu_pd(dst + dst_stride, r1);
+        _mm256_storeu_pd(dst + 2 * dst_stride, r2);
+        _mm256_storeu_pd(dst + 3 * dst_stride, r3);
+    }
+
+    static void swap_transpose(double* a, std::ptrdiff_t a_stride, double* b, std::ptrdiff_t b_stride) {
+        __m256d a0 = _mm256_loadu_pd(a), a1 = _mm256_loadu_pd(a + a_stride), a2 = _mm256_loadu_pd(a + 2 * a_stride), a3 = _mm256_loadu_pd(a + 3 * a_stride);
+        __m256d b0 = _mm256_loadu_pd(b), b1 = _mm256_loadu_pd(b + b_stride), b2 = _mm256_loadu_pd(b + 2 * b_stride), b3 = _mm256_loadu_pd(b + 3 * b_stride);
+        transpose4(a0, a1, a2, a3);
+        transpose4(b0, b1, b2, b3);
+        _mm256_storeu_pd(a, b0);
+        _mm256_storeu_pd(a + a_stride, b1);
+        _mm256_storeu_pd(a + 2 * a_stride, b2);
+        _mm256_storeu_pd(a + 3 * a_stride, b3);
+        _mm256_storeu_pd(b, a0);
+        _mm256_storeu_pd(b + b_stride, a1);
+        _mm256_storeu_pd(b + 2 * b_stride, a2);
+        _mm256_storeu_pd(b + 3 * b_stride, a3);
+    }
+
+private:
+    static void transpose4(__m256d& r0, __m256d& r1, __m256d& r2, __m256d& r3) {
+        const __m256d t0 = _mm256_unpacklo_pd(r0, r1);   // r00 r10 r02 r12
+        const __m256d t1 = _mm256_unpackhi_pd(r0, r1);   // r01 r11 r03 r13
+        const __m256d t2 = _mm256_unpacklo_pd(r2, r3);   // r20 r30 r22 r32
+        const __m256d t3 = _mm256_unpackhi_pd(r2, r3);   // r21 r31 r23 r33
+        r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+        r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+        r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+        r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+    }
+};
+#endif // TINYMATH_SIMD_AVX
+
+// Normalizes four vectors per step with one register per component, so the square root and divisions run four
+// vectors wide. The sums, square root, division and zero test are those of SimdKernel<float, N>::normalized, so
+// results match Vector::normalized bit for bit only when the compiler does not contract multiplies and adds into
+// FMA on its own (e.g. -ffp-contract=off, as for TINYMATH_LEGACY_ACCUMULATION in Config.hpp). With FMA targets
+// and GCC's default contraction the two paths contract differently and about one result in ten differs in the
+// last bit.
+template <int N>
+struct SimdNormalizeBatchOps {
+    static void normalize(const float* in, float* out, size_t count) {
+        const size_t steps = count - count % 4;
+        for (size_t i = 0; i < steps; i += 4) {
+            if constexpr (N == 3) {
+                // x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+                const __m128 a = _mm_loadu_ps(in + 3 * i), b = _mm_loadu_ps(in + 3 * i + 4), c = _mm_loadu_ps(in + 3 * i + 8);
+                __m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+                __m128 y = pick_even(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)));
+                __m128 z = pick_even(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)));
+                const __m128 mag = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+                x = divide_positive(x, mag);
+                y = divide_positive(y, mag);
+                z = divide_positive(z, mag);
+                _mm_storeu_ps(out + 3 * i, pick_even(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0))));
+                _mm_storeu_ps(out + 3 * i + 4, pick_even(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2))));
+                _mm_storeu_ps(out + 3 * i + 8, pick_even(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3))));
+            } else {
+                __m128 x = _mm_loadu_ps(in + 4 * i), y = _mm_loadu_ps(in + 4 * i + 4);
+                __m128 z = _mm_loadu_ps(in + 4 * i + 8), w = _mm_loadu_ps(in + 4 * i + 12);
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+                const __m128 mag = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                                          _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))));
+                x = divide_positive(x, mag);
+                y = divide_positive(y, mag);
+                z = divide_positive(z, mag);
+                w = divide_positive(w, mag);
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+                _mm_storeu_ps(out + 4 * i, x);
+                _mm_storeu_ps(out + 4 * i + 4, y);
+                _mm_storeu_ps(out + 4 * i + 8, z);
+                _mm_storeu_ps(out + 4 * i + 12, w);
+            }
+        }
+        for (size_t i = steps; i < count; ++i)
+            SimdKernel<float, N>::normalized(in + N * i, out + N * i);
+    }
+
+private:
+    // (p0, p2, q0, q2)
+    static __m128 pick_even(__m128 p, __m128 q) { return _mm_shuffle_ps(p, q, _MM_SHUFFLE(2, 0, 2, 0)); }
+    static __m128 divide_positive(__m128 v, __m128 mag) {
+        return SimdKernel<float, 4>::select_positive(mag, _mm_div_ps(v, mag), v);
+    }
+};
+
+template <>
+struct SimdNormalizeBatchKernel<float, 3> : SimdNormalizeBatchOps<3> {
+    static constexpr bool enabled = true;
+};
+
+template <>
+struct SimdNormalizeBatchKernel<float, 4> : SimdNormalizeBatchOps<4> {
+    static constexpr bool enabled = true;
+};
+
+// 4x4 float inverse by 2x2 block cofactors: with M = [A B; C D] every block of the adjugate is a handful of 2x2
+// products, and each 2x2 block (row-major) fits one SSE register
+template <>
+struct SimdInverseKernel<float, 4> {
+    static constexpr bool enabled = true;
+
+    // Writes the inverse of the row-major matrix m to out and returns det(m); out is undefined when det(m) == 0
+    static float inverse(const float* m, float* out) {
+        const __m128 r0 = _mm_loadu_ps(m), r1 = _mm_loadu_ps(m + 4), r2 = _mm_loadu_ps(m + 8), r3 = _mm_loadu_ps(m + 12);
+        const __m128 A = _mm_movelh_ps(r0, r1), B = _mm_movehl_ps(r1, r0);
+        const __m128 C = _mm_movelh_ps(r2, r3), D = _mm_movehl_ps(r3, r2);
+
+        // (|A|, |B|, |C|, |D|)
+        const __m128 dets = _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+            _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+        const __m128 detA = splat<0>(dets), detB = splat<1>(dets), detC = splat<2>(dets), detD = splat<3>(dets);
+
+        const __m128 D_C = adj_mul(D, C);
+        const __m128 A_B = adj_mul(A, B);
+        __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), mul(B, D_C));
+        __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), mul(C, A_B));
+        __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), mul_adj(D, A_B));
+        __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), mul_adj(A, D_C));
+
+        // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+        __m128 tr = _mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+        tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+        tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+        const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+        // The adjugate of each 2x2 block is its transpose with the off-diagonal signs flipped
+        const __m128 scale = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+        X = _mm_mul_ps(X, scale);
+        Y = _mm_mul_ps(Y, scale);
+        Z = _mm_mul_ps(Z, scale);
+        W = _mm_mul_ps(W, scale);
+        _mm_storeu_ps(out, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(out + 4, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+        _mm_storeu_ps(out + 8, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(out + 12, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+        return _mm_cvtss_f32(det);
+    }
+
+private:
+    template <int I>
+    static __m128 splat(__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I)); }
+
+    // a * b
+    static __m128 mul(__m128 a, __m128 b) {
+        return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+    // adj(a) * b
+    static __m128 adj_mul(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+    // a * adj(b)
+    static __m128 mul_adj(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+};
+
+#endif // TINYMATH_SIMD_SSE
+
+// Software prefetch and non-temporal (cache-bypassing) stores for the streaming batch kernels in Streaming.hpp
+#ifdef TINYMATH_SIMD_SSE
+struct SimdStreamKernel {
+    static void prefetch(const void* p) { _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0); }
+
+    // Copies bytes (a multiple of 64) from src to dst, both 64-byte aligned, without reading dst into the cache
+    static void copy(const void* src, void* dst, size_t bytes) {
+        const char* s = static_cast<const char*>(src);
+        char* d = static_cast<char*>(dst);
+        for (size_t i = 0; i < bytes; i += 64) {
+#ifdef TINYMATH_SIMD_AVX
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + i), _mm256_load_si256(reinterpret_cast<const __m256i*>(s + i)));
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + i + 32), _mm256_load_si256(reinterpret_cast<const __m256i*>(s + i + 32)));
+#else
+            for (size_t j = 0; j < 64; j += 16)
+                _mm_stream_si128(reinterpret_cast<__m128i*>(d + i + j), _mm_load_si128(reinterpret_cast<const __m128i*>(s + i + j)));
+#endif
+        }
+    }
+
+    // Orders the non-temporal stores before any later store, so the results are visible once the caller returns
+    static void fence() { _mm_sfence(); }
+};
+#endif // TINYMATH_SIMD_SSE
+
+// 1 / sqrt(x) under a precision policy (see MathUtils.hpp), for x where reciprocal_sqrt_domain(x) holds. float uses the
+// SSE estimate (relative error below 1.5 * 2^-12), refined by one Newton-Raphson step for FastPrecision. A step from
+// that estimate only reaches float precision, so double divides once for FastPrecision and refines the float estimate
+// once for EstimatePrecision. Without SSE both policies divide once.
+template <typename Precision, typename T>
+inline T reciprocal_sqrt(T x) {
+#ifdef TINYMATH_SIMD_SSE
+    if constexpr (std::is_same_v<T, float> && !std::is_same_v<Precision, ExactPrecision>) {
+        const float r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+        if constexpr (std::is_same_v<Precision, EstimatePrecision>)
+            return r;
+        else
+            return r * (1.5f - 0.5f * x * r * r);
+    } else if constexpr (std::is_same_v<T, double> && std::is_same_v<Precision, EstimatePrecision>) {
+        if (reciprocal_sqrt_domain(static_cast<float>(x))) {
+            const double r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(static_cast<float>(x))));
+            return r * (1.5 - 0.5 * x * r * r);
+        }
+    }
+#endif
+    return T(1) / std::sqrt(x);
+}
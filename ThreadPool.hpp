@@ -0,0 +1,199 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Config.hpp"
+#include "Instrumentation.hpp"
+
+// Fixed set of worker threads that execute indexed jobs: run(count, body) calls body(i) for every i in [0, count)
+// on the workers and the calling thread, and returns once all of them have finished.
+// Calls made from inside a job (nested parallelism) run serially on the calling worker.
+// If body throws, indices not yet started are skipped and run() rethrows the first exception on the calling thread
+// once every thread has left the job. Workers take on the caller's instrumentation depth for the job, so instrumented
+// calls inside body count as nested in the call that submitted it, whatever the thread count.
+class ThreadPool {
+public:
+    // threads is the total parallelism including the calling thread; 0 means one per hardware thread
+    explicit ThreadPool(size_t threads = 0) {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        workers.reserve(threads - 1);
+        for (size_t i = 1; i < threads; i++)
+            workers.emplace_back([this] { worker_loop(); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    size_t size() const { return workers.size() + 1; }
+
+    template <typename F>
+    void run(size_t count, F&& body) {
+        if (count == 0)
+            return;
+        if (count == 1 || workers.empty() || inside_job()) {
+            for (size_t i = 0; i < count; i++)
+                body(i);
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit(submit_mutex);
+        std::function<void(size_t)> task = [&body](size_t i) { body(i); };
+        const int depth = Instrumentation::depth();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &task;
+            job_count = count;
+            job_depth = depth;
+            next_index.store(0, std::memory_order_relaxed);
+            remaining = count;
+            generation++;
+        }
+        wake.notify_all();
+        execute(task, count, depth);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return remaining == 0 && active == 0; });
+        job = nullptr;
+        if (std::exception_ptr failure = std::exchange(error, nullptr)) {
+            lock.unlock();
+            std::rethrow_exception(failure);
+        }
+    }
+
+    // Pool used by the library's parallel kernels: a user-supplied pool if one is set, otherwise a library-owned
+    // pool with TINYMATH_NUM_THREADS threads (0 = one per hardware thread)
+    static ThreadPool& current() {
+        if (ThreadPool* pool = user_pool().load(std::memory_order_acquire))
+            return *pool;
+        std::lock_guard<std::mutex> lock(owned_mutex());
+        auto& pool = owned_pool();
+        if (!pool)
+            pool = std::make_unique<ThreadPool>(TINYMATH_NUM_THREADS);
+        return *pool;
+    }
+
+    // Routes library kernels to a caller-owned pool; pass nullptr to return to the library-owned pool.
+    // The pool must outlive every kernel call that may use it.
+    static void set_current(ThreadPool* pool) { user_pool().store(pool, std::memory_order_release); }
+
+    // Recreates the library-owned pool with the given total thread count (0 = one per hardware thread).
+    // Must not be called while library kernels are running on other threads.
+    static void set_thread_count(size_t threads) {
+        std::lock_guard<std::mutex> lock(owned_mutex());
+        auto& pool = owned_pool();
+        pool.reset();
+        pool = std::make_unique<ThreadPool>(threads);
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex submit_mutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(size_t)>* job = nullptr;
+    size_t job_count = 0;
+    int job_depth = 0;          // Instrumentation::depth() of the submitting thread
+    size_t generation = 0;
+    size_t remaining = 0;
+    size_t active = 0;
+    bool stopping = false;
+    std::atomic<size_t> next_index{ 0 };
+    std::exception_ptr error;   // first exception thrown by the current job
+
+    static bool& inside_job() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    static std::atomic<ThreadPool*>& user_pool() {
+        static std::atomic<ThreadPool*> pool{ nullptr };
+        return pool;
+    }
+
+    static std::unique_ptr<ThreadPool>& owned_pool() {
+        static std::unique_ptr<ThreadPool> pool;
+        return pool;
+    }
+
+    static std::mutex& owned_mutex() {
+        static std::mutex m;
+        return m;
+    }
+
+    // Claims indices until the job is exhausted, then reports how many it ran
+    void execute(const std::function<void(size_t)>& task, size_t count, int depth) {
+        const bool was_inside = inside_job();
+        inside_job() = true;
+        const int own_depth = std::exchange(Instrumentation::depth(), depth);
+        size_t finished = 0;
+        for (size_t i = next_index.fetch_add(1, std::memory_order_relaxed); i < count; i = next_index.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                task(i);
+            } catch (...) {
+                // Claims every index nobody has started, so the job drains once the running ones finish
+                const size_t unclaimed = next_index.exchange(count, std::memory_order_relaxed);
+                if (unclaimed < count)
+                    finished += count - unclaimed;
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+            finished++;
+        }
+        inside_job() = was_inside;
+        Instrumentation::depth() = own_depth;
+        if (finished) {
+            std::lock_guard<std::mutex> lock(mutex);
+            remaining -= finished;
+            if (remaining == 0)
+                done.notify_all();
+        }
+    }
+
+    // Workers join a job only while it is still being waited on, so none can touch it after run() returns
+    void worker_loop() {
+        size_t seen = 0;
+        while (true) {
+            const std::function<void(size_t)>* task;
+            size_t count;
+            int depth;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+                if (!job)
+                    continue;
+                task = job;
+                count = job_count;
+                depth = job_depth;
+                active++;
+            }
+            execute(*task, count, depth);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--active == 0)
+                done.notify_all();
+        }
+    }
+};
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include "Config.hpp"
+#include "Simd.hpp"
+
+// Cache-oblivious transposes on raw row-strided storage, used by Matrix and DynMatrix above
+// TINYMATH_TRANSPOSE_BLOCKED_MIN_DIM. Both recursively halve the longer dimension until a block is at most
+// TransposeLeaf x TransposeLeaf, so reads and writes stay blocked at every cache level without a tuned block size;
+// leaves are walked in SimdTransposeKernel tiles where one exists.
+
+constexpr int TransposeLeaf = 16;
+
+// Split point for the recursion: about half, rounded up to whole SIMD tiles so leaves stay tile-aligned
+inline int transpose_split(int n) {
+    return ((n / 2) + 3) & ~3;
+}
+
+// dst (cols x rows) = transpose of src (rows x cols) for a leaf-sized block
+template <typename T>
+void transpose_leaf(int rows, int cols, const T* src, std::ptrdiff_t src_stride, T* dst, std::ptrdiff_t dst_stride) {
+    int i = 0;
+    if constexpr (SimdTransposeKernel<T>::enabled) {
+        constexpr int Tile = SimdTransposeKernel<T>::tile;
+        for (; i + Tile <= rows; i += Tile) {
+            int j = 0;
+            for (; j + Tile <= cols; j += Tile)
+                SimdTransposeKernel<T>::transpose(src + i * src_stride + j, src_stride, dst + j * dst_stride + i, dst_stride);
+            for (; j < cols; ++j) {
+                for (int ii = i; ii < i + Tile; ++ii)
+                    dst[j * dst_stride + ii] = src[ii * src_stride + j];
+            }
+        }
+    }
+    for (; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j)
+            dst[j * dst_stride + i] = src[i * src_stride + j];
+    }
+}
+
+// dst (cols x rows) = transpose of src (rows x cols); the two must not overlap
+template <typename T>
+void transpose_blocked(int rows, int cols, const T* src, std::ptrdiff_t src_stride, T* dst, std::ptrdiff_t dst_stride) {
+    if (rows <= TransposeLeaf && cols <= TransposeLeaf) {
+        transpose_leaf(rows, cols, src, src_stride, dst, dst_stride);
+    } else if (rows >= cols) {
+        const int half = transpose_split(rows);
+        transpose_blocked(half, cols, src, src_stride, dst, dst_stride);
+        transpose_blocked(rows - half, cols, src + half * src_stride, src_stride, dst + half, dst_stride);
+    } else {
+        const int half = transpose_split(cols);
+        transpose_blocked(rows, half, src, src_stride, dst, dst_stride);
+        transpose_blocked(rows, cols - half, src + half, src_stride, dst + half * dst_stride, dst_stride);
+    }
+}
+
+// Exchanges a (rows x cols) with the transpose of b (cols x rows): the mirrored off-diagonal blocks of an in-place
+// transpose, both inside the same storage with row stride stride
+template <typename T>
+void transpose_swap_blocked(int rows, int cols, T* a, T* b, std::ptrdiff_t stride) {
+    if (rows <= TransposeLeaf && cols <= TransposeLeaf) {
+        int i = 0;
+        if constexpr (SimdTransposeKernel<T>::enabled) {
+            constexpr int Tile = SimdTransposeKernel<T>::tile;
+            for (; i + Tile <= rows; i += Tile) {
+                int j = 0;
+                for (; j + Tile <= cols; j += Tile)
+                    SimdTransposeKernel<T>::swap_transpose(a + i * stride + j, stride, b + j * stride + i, stride);
+                for (; j < cols; ++j) {
+                    for (int ii = i; ii < i + Tile; ++ii)
+                        std::swap(a[ii * stride + j], b[j * stride + ii]);
+                }
+            }
+        }
+        for (; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j)
+                std::swap(a[i * stride + j], b[j * stride + i]);
+        }
+    } else if (rows >= cols) {
+        const int half = transpose_split(rows);
+        transpose_swap_blocked(half, cols, a, b, stride);
+        transpose_swap_blocked(rows - half, cols, a + half * stride, b + half, stride);
+    } else {
+        const int half = transpose_split(cols);
+        transpose_swap_blocked(rows, half, a, b, stride);
+        transpose_swap_blocked(rows, cols - half, a + half, b + half * stride, stride);
+    }
+}
+
+// In-place transpose of the n x n matrix at a: diagonal blocks recurse, mirrored off-diagonal blocks swap
+template <typename T>
+void transpose_square_blocked(int n, T* a, std::ptrdiff_t stride) {
+    if (n <= TransposeLeaf) {
+        int i = 0;
+        if constexpr (SimdTransposeKernel<T>::enabled) {
+            constexpr int Tile = SimdTransposeKernel<T>::tile;
+            for (; i + Tile <= n; i += Tile) {
+                T* diagonal = a + i * stride + i;
+                SimdTransposeKernel<T>::transpose(diagonal, stride, diagonal, stride);
+                int j = i + Tile;
+                for (; j + Tile <= n; j += Tile)
+                    SimdTransposeKernel<T>::swap_transpose(a + i * stride + j, stride, a + j * stride + i, stride);
+                for (; j < n; ++j) {
+                    for (int ii = i; ii < i + Tile; ++ii)
+                        std::swap(a[ii * stride + j], a[j * stride + ii]);
+                }
+            }
+        }
+        for (; i < n; ++i) {
+            for (int j = i + 1; j < n; ++j)
+                std::swap(a[i * stride + j], a[j * stride + i]);
+        }
+        return;
+    }
+    const int half = transpose_split(n);
+    transpose_square_blocked(half, a, stride);
+    transpose_square_blocked(n - half, a + half * stride + half, stride);
+    transpose_swap_blocked(half, n - half, a + half, a + half * stride, stride);
+}
@@ -1,148 +1,352 @@
-#pragma once
-#include <iostream>
-#include <array>
-#include <algorithm>
-#include <type_traits>
-
-template <typename T, int N>
-class Vector {
-public:
-    std::array<T, N> data{};
-
-    Vector() { data.fill(0); }
-    Vector(std::initializer_list<T> values) {
-        std::copy_n(values.begin(), std::min(N, static_cast<int>(values.size())), data.begin());
-    }
-
-    // Element-wise vector operations
-    Vector operator+(const Vector& other) const { return apply(other, std::plus<>()); }
-    Vector operator-(const Vector& other) const { return apply(other, std::minus<>()); }
-    Vector operator*(const Vector& other) const { return apply(other, std::multiplies<>()); }
-    Vector operator/(const Vector& other) const { return apply(other, std::divides<>()); }
-
-    Vector& operator+=(const Vector& other) { return apply_self(other, std::plus<>()); }
-    Vector& operator-=(const Vector& other) { return apply_self(other, std::minus<>()); }
-    Vector& operator*=(const Vector& other) { return apply_self(other, std::multiplies<>()); }
-    Vector& operator/=(const Vector& other) { return apply_self(other, std::divides<>()); }
-
-    // Scalar operations
-    Vector operator+(const T& scalar) const { return apply_scalar(scalar, std::plus<>()); }
-    Vector operator-(const T& scalar) const { return apply_scalar(scalar, std::minus<>()); }
-    Vector operator*(const T& scalar) const { return apply_scalar(scalar, std::multiplies<>()); }
-    Vector operator/(const T& scalar) const { return apply_scalar(scalar, std::divides<>()); }
-
-    Vector& operator+=(const T& scalar) { return apply_scalar_self(scalar, std::plus<>()); }
-    Vector& operator-=(const T& scalar) { return apply_scalar_self(scalar, std::minus<>()); }
-    Vector& operator*=(const T& scalar) { return apply_scalar_self(scalar, std::multiplies<>()); }
-    Vector& operator/=(const T& scalar) { return apply_scalar_self(scalar, std::divides<>()); }
-
-    // Vector utilities
-    T dot(const Vector& other) const {
-        T result = 0;
-        for (size_t i = 0; i < N; i++)
-            result += data[i] * other.data[i];
-        return result;
-    }
-
-    T magnitude() const {
-        return std::sqrt(dot(*this));
-    }
-
-    Vector normalized() const {
-        T mag = magnitude();
-        return (mag > 0) ? *this / mag : *this;
-    }
-
-    static T distance(const Vector& a, const Vector& b) {
-        return (a - b).magnitude();
-    }
-
-    Vector& normalize() {
-        *this = normalized();
-        return *this;
-    }
-
-    // Cross Product (only for Vec3)
-    template <typename U = T>
-    Vector cross(const Vector<U, 3>& other) const {
-        static_assert(N == 3, "Cross product is only valid for 3D vectors.");
-        return Vector{
-            data[1] * other.data[2] - data[2] * other.data[1],
-            data[2] * other.data[0] - data[0] * other.data[2],
-            data[0] * other.data[1] - data[1] * other.data[0]
-        };
-    }
-
-    // Clamp values within min-max range
-    Vector clamp(const T& minVal, const T& maxVal) const {
-        Vector result;
-        for (size_t i = 0; i < N; i++)
-            result.data[i] = std::clamp(data[i], minVal, maxVal);
-        return result;
-    }
-
-    // Linear interpolation
-    static Vector lerp(const Vector& start, const Vector& end, T t) {
-        return start + (end - start) * t;
-    }
-
-    // Reflection over a normal
-    Vector reflect(const Vector& normal) const {
-        return *this - normal * (2 * dot(normal));
-    }
-
-    // Operators
-    bool operator==(const Vector& other) const { return data == other.data; }
-    bool operator!=(const Vector& other) const { return !(*this == other); }
-    Vector operator-() const { return *this * -1; }
-    T& operator[](size_t index) { return data[index]; }
-    const T& operator[](size_t index) const { return data[index]; }
-
-    void print() const {
-        std::cout << "(";
-        for (size_t i = 0; i < N; i++)
-            std::cout << data[i] << (i < N - 1 ? ", " : "");
-        std::cout << ")\n";
-    }
-
-private:
-    template <typename Op>
-    Vector apply(const Vector& other, Op op) const {
-        Vector result;
-        std::transform(data.begin(), data.end(), other.data.begin(), result.data.begin(), op);
-        return result;
-    }
-
-    template <typename Op>
-    Vector& apply_self(const Vector& other, Op op) {
-        std::transform(data.begin(), data.end(), other.data.begin(), data.begin(), op);
-        return *this;
-    }
-
-    template <typename Op>
-    Vector apply_scalar(const T& scalar, Op op) const {
-        Vector result;
-        std::transform(data.begin(), data.end(), result.data.begin(), [&](T x) { return op(x, scalar); });
-        return result;
-    }
-
-    template <typename Op>
-    Vector& apply_scalar_self(const T& scalar, Op op) {
-        std::transform(data.begin(), data.end(), data.begin(), [&](T x) { return op(x, scalar); });
-        return *this;
-    }
-};
-
-// Aliases
-template <typename T> using vec2 = Vector<T, 2>;
-template <typename T> using vec3 = Vector<T, 3>;
-template <typename T> using vec4 = Vector<T, 4>;
-template <typename T> using Vec2 = Vector<T, 2>;
-template <typename T> using Vec3 = Vector<T, 3>;
-template <typename T> using Vec4 = Vector<T, 4>;
-template <typename T> using Vector2 = Vector<T, 2>;
-template <typename T> using Vector3 = Vector<T, 3>;
-template <typename T> using Vector4 = Vector<T, 4>;
-template <typename T> using vector2 = Vector<T, 2>;
-template <typename T> using vector3 = Vector<T, 3>;
+#pragma once
+#include <iostream>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <cmath>
+#include <cassert>
+#include <span>
+#include "AlignedAllocator.hpp"
+#include "Instrumentation.hpp"
+#include "Simd.hpp"
+#include "Reduction.hpp"
+#include "Streaming.hpp"
+#include "MathUtils.hpp"
+#include "Expression.hpp"
+
+// Power-of-two sized vectors (e.g. float x 4, double x 4) are aligned to their size; see TINYMATH_MAX_ALIGNMENT
+template <typename T, int N>
+class alignas(storage_alignment<T, N>()) Vector {
+public:
+    std::array<T, N> data{};
+
+    constexpr Vector() = default;
+    constexpr Vector(std::initializer_list<T> values) {
+        std::copy_n(values.begin(), std::min(N, static_cast<int>(values.size())), data.begin());
+    }
+
+    // Evaluate a lazy expression (see Expression.hpp) in a single loop
+    template <typename E>
+    constexpr Vector(const VectorExpr<E>& expr) { assign(expr.self()); }
+    template <typename E>
+    constexpr Vector& operator=(const VectorExpr<E>& expr) { return assign(expr.self()); }
+
+    // Element-wise vector operations
+    constexpr Vector operator+(const Vector& other) const { return apply(other, std::plus<>()); }
+    constexpr Vector operator-(const Vector& other) const { return apply(other, std::minus<>()); }
+    constexpr Vector operator*(const Vector& other) const { return apply(other, std::multiplies<>()); }
+    constexpr Vector operator/(const Vector& other) const { return apply(other, std::divides<>()); }
+
+    constexpr Vector& operator+=(const Vector& other) { return apply_self(other, std::plus<>()); }
+    constexpr Vector& operator-=(const Vector& other) { return apply_self(other, std::minus<>()); }
+    constexpr Vector& operator*=(const Vector& other) { return apply_self(other, std::multiplies<>()); }
+    constexpr Vector& operator/=(const Vector& other) { return apply_self(other, std::divides<>()); }
+
+    // Scalar operations
+    constexpr Vector operator+(const T& scalar) const { return apply_scalar(scalar, std::plus<>()); }
+    constexpr Vector operator-(const T& scalar) const { return apply_scalar(scalar, std::minus<>()); }
+    constexpr Vector operator*(const T& scalar) const { return apply_scalar(scalar, std::multiplies<>()); }
+    constexpr Vector operator/(const T& scalar) const { return apply_scalar(scalar, std::divides<>()); }
+
+    constexpr Vector& operator+=(const T& scalar) { return apply_scalar_self(scalar, std::plus<>()); }
+    constexpr Vector& operator-=(const T& scalar) { return apply_scalar_self(scalar, std::minus<>()); }
+    constexpr Vector& operator*=(const T& scalar) { return apply_scalar_self(scalar, std::multiplies<>()); }
+    constexpr Vector& operator/=(const T& scalar) { return apply_scalar_self(scalar, std::divides<>()); }
+
+    // Vector utilities
+    // Policy picks exact sequential or fused multiply-add accumulation (see MathUtils.hpp)
+    template <typename Policy = DefaultAccumulation>
+    constexpr T dot(const Vector& other) const {
+        TINYMATH_INSTRUMENT_SCOPE(VectorDot, 2 * N);
+        if constexpr (SimdKernel<T, N>::has_arithmetic && std::is_same_v<Policy, FusedAccumulation>) {
+            if (!std::is_constant_evaluated())
+                return SimdKernel<T, N>::dot(data.data(), other.data.data());
+        }
+        return dot_product<Policy, N>(data.data(), other.data.data());
+    }
+
+    // Precision picks the exact square root and division or a multiply by a reciprocal square root estimate (see
+    // MathUtils.hpp). The estimates only cover positive, normal, finite squared lengths; zero, subnormal and infinite
+    // ones take the exact path, so zero vectors still normalize to themselves.
+    template <typename Precision = ExactPrecision>
+    constexpr T magnitude() const {
+        TINYMATH_INSTRUMENT_SCOPE(VectorMagnitude, 2 * N + 1);
+        if constexpr (uses_reciprocal_sqrt<Precision>()) {
+            if (!std::is_constant_evaluated()) {
+                if constexpr (SimdKernel<T, N>::has_rsqrt) {
+                    T result;
+                    if (SimdKernel<T, N>::template magnitude_rsqrt<Precision>(data.data(), result))
+                        return result;
+                } else {
+                    const T squared = dot(*this);
+                    if (reciprocal_sqrt_domain(squared))
+                        return squared * reciprocal_sqrt<Precision>(squared);
+                }
+            }
+        }
+        return math_sqrt(dot(*this));
+    }
+
+    template <typename Precision = ExactPrecision>
+    constexpr Vector normalized() const {
+        TINYMATH_INSTRUMENT_SCOPE(VectorNormalize, 3 * N + 1);
+        if constexpr (uses_reciprocal_sqrt<Precision>()) {
+            if (!std::is_constant_evaluated()) {
+                if constexpr (SimdKernel<T, N>::has_rsqrt) {
+                    Vector result;
+                    if (SimdKernel<T, N>::template normalized_rsqrt<Precision>(data.data(), result.data.data()))
+                        return result;
+                } else {
+                    const T squared = dot(*this);
+                    if (reciprocal_sqrt_domain(squared))
+                        return *this * reciprocal_sqrt<Precision>(squared);
+                }
+            }
+        }
+        if constexpr (SimdKernel<T, N>::enabled) {
+            if (!std::is_constant_evaluated()) {
+                Vector result;
+                SimdKernel<T, N>::normalized(data.data(), result.data.data());
+                return result;
+            }
+        }
+        T mag = magnitude();
+        return (mag > 0) ? *this / mag : *this;
+    }
+
+    template <typename Precision = ExactPrecision>
+    static constexpr T distance(const Vector& a, const Vector& b) {
+        return (a - b).template magnitude<Precision>();
+    }
+
+    // Squared distance: no square root, and the same order as distance() when ranking or comparing against a
+    // squared radius. Policy is the accumulation policy of dot().
+    template <typename Policy = DefaultAccumulation>
+    static constexpr T distance_squared(const Vector& a, const Vector& b) {
+        const Vector d = a - b;
+        return d.template dot<Policy>(d);
+    }
+
+    template <typename Precision = ExactPrecision>
+    constexpr Vector& normalize() {
+        *this = normalized<Precision>();
+        return *this;
+    }
+
+    // Batched normalized() and scaling: out[i] = in[i].normalized(), out[i] = in[i] * scalar; out may be in itself.
+    // Outputs of at least TINYMATH_STREAMING_MIN_BYTES bypass the cache (see Streaming.hpp), and large inputs are
+    // split across threads unless allow_threads is false.
+    static void normalize_batch(std::span<const Vector> in, std::span<Vector> out, bool allow_threads = true) {
+        TINYMATH_INSTRUMENT_SCOPE(VectorNormalizeBatch, (3.0 * N + 1) * in.size());
+        assert(in.size() == out.size());
+        stream_batch(in.data(), out.data(), in.size(), allow_threads, [](const Vector* src, Vector* dst, size_t count) {
+            if constexpr (SimdNormalizeBatchKernel<T, N>::enabled) {
+                static_assert(sizeof(Vector) == N * sizeof(T), "Vectors must be tightly packed.");
+                if (count > 0)
+                    SimdNormalizeBatchKernel<T, N>::normalize(src[0].data.data(), dst[0].data.data(), count);
+            } else {
+                for (size_t i = 0; i < count; ++i)
+                    dst[i] = src[i].normalized();
+            }
+        });
+    }
+
+    static void scale_batch(std::span<const Vector> in, const T& scalar, std::span<Vector> out, bool allow_threads = true) {
+        TINYMATH_INSTRUMENT_SCOPE(VectorScaleBatch, double(N) * in.size());
+        assert(in.size() == out.size());
+        stream_batch(in.data(), out.data(), in.size(), allow_threads, [&scalar](const Vector* src, Vector* dst, size_t count) {
+            for (size_t i = 0; i < count; ++i)
+                dst[i] = src[i] * scalar;
+        });
+    }
+
+    // Reductions over arrays of vectors (see Reduction.hpp), split across threads for large inputs unless
+    // allow_threads is false. Summation picks pairwise or compensated sums (see MathUtils.hpp); either way the result
+    // does not depend on the number of threads.
+    template <typename Summation = PairwiseSummation>
+    static Vector sum(std::span<const Vector> values, bool allow_threads = true) {
+        TINYMATH_INSTRUMENT_SCOPE(VectorReduction, double(N) * values.size());
+        static_assert(sizeof(Vector) == N * sizeof(T), "Vectors must be tightly packed.");
+        const ReductionSum<T, N> total = reduce_blocks<T, N>(reinterpret_cast<const T*>(values.data()), values.size(), allow_threads,
+            sum_block<Summation, T, N>, combine_sums<Summation, T, N>);
+        Vector result;
+        for (int c = 0; c < N; ++c)
+            result.data[c] = total.sum[c] + total.error[c];
+        return result;
+    }
+
+    template <typename Summation = PairwiseSummation>
+    static Vector mean(std::span<const Vector> values, bool allow_threads = true) {
+        assert(!values.empty() && "Mean of an empty range.");
+        return sum<Summation>(values, allow_threads) / static_cast<T>(values.size());
+    }
+
+    // Component-wise minimum and maximum; NaN components are skipped
+    static Vector min(std::span<const Vector> values, bool allow_threads = true) {
+        return bounds<true, false>(values, allow_threads).min;
+    }
+
+    static Vector max(std::span<const Vector> values, bool allow_threads = true) {
+        return bounds<false, true>(values, allow_threads).max;
+    }
+
+    struct Bounds {
+        Vector min;
+        Vector max;
+    };
+
+    // Corners of the axis-aligned box enclosing every vector
+    static Bounds bounding_box(std::span<const Vector> values, bool allow_threads = true) {
+        return bounds<true, true>(values, allow_threads);
+    }
+
+    // Smallest magnitude(), comparing squared lengths
+    static T min_magnitude(std::span<const Vector> values, bool allow_threads = true) {
+        TINYMATH_INSTRUMENT_SCOPE(VectorReduction, 2.0 * N * values.size());
+        static_assert(sizeof(Vector) == N * sizeof(T), "Vectors must be tightly packed.");
+        assert(!values.empty() && "Minimum of an empty range.");
+        return math_sqrt(reduce_blocks<T, N>(reinterpret_cast<const T*>(values.data()), values.size(), allow_threads,
+            min_squared_block<T, N>, [](T a, T b) { return b < a ? b : a; }));
+    }
+
+    // Cross Product (only for Vec3)
+    template <typename U = T>
+    constexpr Vector cross(const Vector<U, 3>& other) const {
+        static_assert(N == 3, "Cross product is only valid for 3D vectors.");
+        TINYMATH_INSTRUMENT_SCOPE(VectorCross, 9);
+        return Vector{
+            data[1] * other.data[2] - data[2] * other.data[1],
+            data[2] * other.data[0] - data[0] * other.data[2],
+            data[0] * other.data[1] - data[1] * other.data[0]
+        };
+    }
+
+    // Clamp values within min-max range
+    constexpr Vector clamp(const T& minVal, const T& maxVal) const {
+        Vector result;
+        for (size_t i = 0; i < N; i++)
+            result.data[i] = std::clamp(data[i], minVal, maxVal);
+        return result;
+    }
+
+    // Linear interpolation
+    static constexpr Vector lerp(const Vector& start, const Vector& end, T t) {
+        return lazy(start) + (lazy(end) - lazy(start)) * t;
+    }
+
+    // Reflection over a normal
+    constexpr Vector reflect(const Vector& normal) const {
+        return lazy(*this) - lazy(normal) * (2 * dot(normal));
+    }
+
+    // Operators
+    constexpr bool operator==(const Vector& other) const { return data == other.data; }
+    constexpr bool operator!=(const Vector& other) const { return !(*this == other); }
+    constexpr Vector operator-() const { return *this * -1; }
+    constexpr T& operator[](size_t index) { return data[index]; }
+    constexpr const T& operator[](size_t index) const { return data[index]; }
+
+    void print() const {
+        std::cout << "(";
+        for (size_t i = 0; i < N; i++)
+            std::cout << data[i] << (i < N - 1 ? ", " : "");
+        std::cout << ")\n";
+    }
+
+private:
+    // Integer vectors have no reciprocal square root path; their magnitudes stay exact
+    template <typename Precision>
+    static constexpr bool uses_reciprocal_sqrt() {
+        return !std::is_same_v<Precision, ExactPrecision> && std::is_floating_point_v<T>;
+    }
+
+    template <bool Min, bool Max>
+    static Bounds bounds(std::span<const Vector> values, bool allow_threads) {
+        TINYMATH_INSTRUMENT_SCOPE(VectorReduction, double(Min + Max) * N * values.size());
+        static_assert(sizeof(Vector) == N * sizeof(T), "Vectors must be tightly packed.");
+        assert(!values.empty() && "Bounds of an empty range.");
+        const ReductionBounds<T, N> box = reduce_blocks<T, N>(reinterpret_cast<const T*>(values.data()), values.size(), allow_threads,
+            bounds_block<Min, Max, T, N>, combine_bounds<T, N>);
+        Bounds result;
+        result.min.data = box.min;
+        result.max.data = box.max;
+        return result;
+    }
+
+    template <typename E>
+    constexpr Vector& assign(const E& expr) {
+        static_assert(E::size == N, "Vector expression size must match the destination size.");
+        for (size_t i = 0; i < N; i++)
+            data[i] = expr[i];
+        return *this;
+    }
+
+    template <typename Op>
+    constexpr Vector apply(const Vector& other, Op op) const {
+        TINYMATH_INSTRUMENT_SCOPE(VectorElementwise, N);
+        Vector result;
+        if constexpr (SimdKernel<T, N>::has_arithmetic && simd_supported_op<Op>) {
+            if (!std::is_constant_evaluated()) {
+                SimdKernel<T, N>::binary(data.data(), other.data.data(), result.data.data(), op);
+                return result;
+            }
+        }
+        std::transform(data.begin(), data.end(), other.data.begin(), result.data.begin(), op);
+        return result;
+    }
+
+    template <typename Op>
+    constexpr Vector& apply_self(const Vector& other, Op op) {
+        TINYMATH_INSTRUMENT_SCOPE(VectorElementwise, N);
+        if constexpr (SimdKernel<T, N>::has_arithmetic && simd_supported_op<Op>) {
+            if (!std::is_constant_evaluated()) {
+                SimdKernel<T, N>::binary(data.data(), other.data.data(), data.data(), op);
+                return *this;
+            }
+        }
+        std::transform(data.begin(), data.end(), other.data.begin(), data.begin(), op);
+        return *this;
+    }
+
+    template <typename Op>
+    constexpr Vector apply_scalar(const T& scalar, Op op) const {
+        TINYMATH_INSTRUMENT_SCOPE(VectorElementwise, N);
+        Vector result;
+        if constexpr (SimdKernel<T, N>::has_arithmetic && simd_supported_op<Op>) {
+            if (!std::is_constant_evaluated()) {
+                SimdKernel<T, N>::scalar(data.data(), scalar, result.data.data(), op);
+                return result;
+            }
+        }
+        std::transform(data.begin(), data.end(), result.data.begin(), [&](T x) { return op(x, scalar); });
+        return result;
+    }
+
+    template <typename Op>
+    constexpr Vector& apply_scalar_self(const T& scalar, Op op) {
+        TINYMATH_INSTRUMENT_SCOPE(VectorElementwise, N);
+        if constexpr (SimdKernel<T, N>::has_arithmetic && simd_supported_op<Op>) {
+            if (!std::is_constant_evaluated()) {
+                SimdKernel<T, N>::scalar(data.data(), scalar, data.data(), op);
+                return *this;
+            }
+        }
+        std::transform(data.begin(), data.end(), data.begin(), [&](T x) { return op(x, scalar); });
+        return *this;
+    }
+};
+
+// Aliases
+template <typename T> using vec2 = Vector<T, 2>;
+template <typename T> using vec3 = Vector<T, 3>;
+template <typename T> using vec4 = Vector<T, 4>;
+template <typename T> using Vec2 = Vector<T, 2>;
+template <typename T> using Vec3 = Vector<T, 3>;
+template <typename T> using Vec4 = Vector<T, 4>;
+template <typename T> using Vector2 = Vector<T, 2>;
+template <typename T> using Vector3 = Vector<T, 3>;
+template <typename T> using Vector4 = Vector<T, 4>;
+template <typename T> using vector2 = Vector<T, 2>;
+template <typename T> using vector3 = Vector<T, 3>;
 template <typename T> using vector4 = Vector<T, 4>;
\ No newline at end of file
@@ -0,0 +1,254 @@
+#pragma once
+#include <array>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+#include "AlignedAllocator.hpp"
+#include "Vector.hpp"
+
+// Structure-of-arrays container for many Vector<T, N>: component c of every vector is stored contiguously in
+// lanes[c] (64-byte aligned), so each batch operation is a straight loop over plain arrays that the compiler
+// vectorizes across vectors instead of within one.
+template <typename T, int N>
+class VectorBatch {
+public:
+    using Lane = AlignedArray<T>;
+
+    std::array<Lane, N> lanes{};
+
+    VectorBatch() = default;
+    explicit VectorBatch(size_t count) { resize(count); }
+    VectorBatch(std::span<const Vector<T, N>> vectors) {
+        resize(vectors.size());
+        for (size_t i = 0; i < vectors.size(); i++)
+            set(i, vectors[i]);
+    }
+
+    size_t size() const { return lanes[0].size(); }
+    void resize(size_t count) {
+        for (auto& lane : lanes)
+            lane.resize(count);
+    }
+
+    T* lane(int component) { return lanes[component].data(); }
+    const T* lane(int component) const { return lanes[component].data(); }
+
+    // Conversion to and from arrays of Vector
+    Vector<T, N> get(size_t index) const {
+        Vector<T, N> result;
+        for (int c = 0; c < N; c++)
+            result[c] = lanes[c][index];
+        return result;
+    }
+
+    void set(size_t index, const Vector<T, N>& vec) {
+        for (int c = 0; c < N; c++)
+            lanes[c][index] = vec[c];
+    }
+
+    void store(std::span<Vector<T, N>> out) const {
+        assert(out.size() == size());
+        for (size_t i = 0; i < out.size(); i++)
+            out[i] = get(i);
+    }
+
+    std::vector<Vector<T, N>> to_vectors() const {
+        std::vector<Vector<T, N>> result(size());
+        store(result);
+        return result;
+    }
+
+    // Element-wise batch operations
+    VectorBatch operator+(const VectorBatch& other) const { return apply(other, std::plus<>()); }
+    VectorBatch operator-(const VectorBatch& other) const { return apply(other, std::minus<>()); }
+    VectorBatch operator*(const VectorBatch& other) const { return apply(other, std::multiplies<>()); }
+    VectorBatch operator/(const VectorBatch& other) const { return apply(other, std::divides<>()); }
+
+    VectorBatch& operator+=(const VectorBatch& other) { return apply_self(other, std::plus<>()); }
+    VectorBatch& operator-=(const VectorBatch& other) { return apply_self(other, std::minus<>()); }
+    VectorBatch& operator*=(const VectorBatch& other) { return apply_self(other, std::multiplies<>()); }
+    VectorBatch& operator/=(const VectorBatch& other) { return apply_self(other, std::divides<>()); }
+
+    // Scalar operations
+    VectorBatch operator+(const T& scalar) const { return apply_scalar(scalar, std::plus<>()); }
+    VectorBatch operator-(const T& scalar) const { return apply_scalar(scalar, std::minus<>()); }
+    VectorBatch operator*(const T& scalar) const { return apply_scalar(scalar, std::multiplies<>()); }
+    VectorBatch operator/(const T& scalar) const { return apply_scalar(scalar, std::divides<>()); }
+
+    VectorBatch& operator+=(const T& scalar) { return apply_scalar_self(scalar, std::plus<>()); }
+    VectorBatch& operator-=(const T& scalar) { return apply_scalar_self(scalar, std::minus<>()); }
+    VectorBatch& operator*=(const T& scalar) { return apply_scalar_self(scalar, std::multiplies<>()); }
+    VectorBatch& operator/=(const T& scalar) { return apply_scalar_self(scalar, std::divides<>()); }
+
+    // Vector utilities, one result per vector
+    Lane dot(const VectorBatch& other) const {
+        assert(other.size() == size());
+        const size_t count = size();
+        Lane result(count);
+        T* out = result.data();
+        for (int c = 0; c < N; c++) {
+            const T* a = lane(c);
+            const T* b = other.lane(c);
+            for (size_t i = 0; i < count; i++)
+                out[i] += a[i] * b[i];
+        }
+        return result;
+    }
+
+    Lane magnitude() const {
+        Lane result = dot(*this);
+        for (auto& value : result)
+            value = std::sqrt(value);
+        return result;
+    }
+
+    static Lane distance(const VectorBatch& a, const VectorBatch& b) {
+        assert(a.size() == b.size());
+        const size_t count = a.size();
+        Lane result(count);
+        T* out = result.data();
+        for (int c = 0; c < N; c++) {
+            const T* pa = a.lane(c);
+            const T* pb = b.lane(c);
+            for (size_t i = 0; i < count; i++) {
+                const T d = pa[i] - pb[i];
+                out[i] += d * d;
+            }
+        }
+        for (size_t i = 0; i < count; i++)
+            out[i] = std::sqrt(out[i]);
+        return result;
+    }
+
+    VectorBatch normalized() const {
+        VectorBatch result(size());
+        normalize_into(result);
+        return result;
+    }
+
+    VectorBatch& normalize() {
+        normalize_into(*this);
+        return *this;
+    }
+
+    // Cross product (only for Vec3)
+    VectorBatch cross(const VectorBatch& other) const {
+        static_assert(N == 3, "Cross product is only valid for 3D vectors.");
+        assert(other.size() == size());
+        const size_t count = size();
+        VectorBatch result(count);
+        const T *ax = lane(0), *ay = lane(1), *az = lane(2);
+        const T *bx = other.lane(0), *by = other.lane(1), *bz = other.lane(2);
+        T *rx = result.lane(0), *ry = result.lane(1), *rz = result.lane(2);
+        for (size_t i = 0; i < count; i++) {
+            rx[i] = ay[i] * bz[i] - az[i] * by[i];
+            ry[i] = az[i] * bx[i] - ax[i] * bz[i];
+            rz[i] = ax[i] * by[i] - ay[i] * bx[i];
+        }
+        return result;
+    }
+
+    // Clamp values within min-max range
+    VectorBatch clamp(const T& minVal, const T& maxVal) const {
+        const size_t count = size();
+        VectorBatch result(count);
+        for (int c = 0; c < N; c++) {
+            const T* in = lane(c);
+            T* out = result.lane(c);
+            for (size_t i = 0; i < count; i++)
+                out[i] = std::clamp(in[i], minVal, maxVal);
+        }
+        return result;
+    }
+
+    // Linear interpolation
+    static VectorBatch lerp(const VectorBatch& start, const VectorBatch& end, T t) {
+        assert(start.size() == end.size());
+        const size_t count = start.size();
+        VectorBatch result(count);
+        for (int c = 0; c < N; c++) {
+            const T* a = start.lane(c);
+            const T* b = end.lane(c);
+            T* out = result.lane(c);
+            for (size_t i = 0; i < count; i++)
+                out[i] = a[i] + (b[i] - a[i]) * t;
+        }
+        return result;
+    }
+
+    // Reflection over per-vector normals
+    VectorBatch reflect(const VectorBatch& normal) const {
+        const Lane d = dot(normal);
+        const size_t count = size();
+        VectorBatch result(count);
+        for (int c = 0; c < N; c++) {
+            const T* in = lane(c);
+            const T* n = normal.lane(c);
+            T* out = result.lane(c);
+            for (size_t i = 0; i < count; i++)
+                out[i] = in[i] - n[i] * (2 * d[i]);
+        }
+        return result;
+    }
+
+private:
+    // One pass over the vectors; all N lanes are read and written per index so the magnitude stays in registers
+    void normalize_into(VectorBatch& result) const {
+        const size_t count = size();
+        std::array<const T*, N> in;
+        std::array<T*, N> out;
+        for (int c = 0; c < N; c++) {
+            in[c] = lane(c);
+            out[c] = result.lane(c);
+        }
+        for (size_t i = 0; i < count; i++) {
+            T sum = 0;
+            for (int c = 0; c < N; c++)
+                sum += in[c][i] * in[c][i];
+            const T mag = std::sqrt(sum);
+            for (int c = 0; c < N; c++)
+                out[c][i] = (mag > 0) ? in[c][i] / mag : in[c][i];
+        }
+    }
+
+    template <typename Op>
+    VectorBatch apply(const VectorBatch& other, Op op) const {
+        assert(other.size() == size());
+        VectorBatch result(size());
+        for (int c = 0; c < N; c++)
+            std::transform(lanes[c].begin(), lanes[c].end(), other.lanes[c].begin(), result.lanes[c].begin(), op);
+        return result;
+    }
+
+    template <typename Op>
+    VectorBatch& apply_self(const VectorBatch& other, Op op) {
+        assert(other.size() == size());
+        for (int c = 0; c < N; c++)
+            std::transform(lanes[c].begin(), lanes[c].end(), other.lanes[c].begin(), lanes[c].begin(), op);
+        return *this;
+    }
+
+    template <typename Op>
+    VectorBatch apply_scalar(const T& scalar, Op op) const {
+        VectorBatch result(size());
+        for (int c = 0; c < N; c++)
+            std::transform(lanes[c].begin(), lanes[c].end(), result.lanes[c].begin(), [&](T x) { return op(x, scalar); });
+        return result;
+    }
+
+    template <typename Op>
+    VectorBatch& apply_scalar_self(const T& scalar, Op op) {
+        for (int c = 0; c < N; c++)
+            std::transform(lanes[c].begin(), lanes[c].end(), lanes[c].begin(), [&](T x) { return op(x, scalar); });
+        return *this;
+    }
+};
+
+// Aliases
+template <typename T> using vec2batch = VectorBatch<T, 2>;
+template <typename T> using vec3batch = VectorBatch<T, 3>;
+template <typename T> using vec4batch = VectorBatch<T, 4>;
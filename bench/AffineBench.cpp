@@ -0,0 +1,99 @@
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../Affine3.hpp"
+
+// Affine3 (3x4, implicit bottom row) against the same operations on full Matrix<T, 4, 4>, including a scene-graph
+// update: world[n] = world[parent[n]] * local[n] over SceneNodes nodes in parent-before-child order.
+
+constexpr size_t SceneNodes = 4096;
+
+template <typename T>
+Affine3<T> bench_affine(size_t seed) {
+    Vector<T, 3> axis, offset;
+    bench_fill(axis.data.data(), 3, seed);
+    bench_fill(offset.data.data(), 3, seed + 3);
+    return Affine3<T>::translate(offset) * Affine3<T>::rotate(axis.normalized(), bench_value<T>(seed + 6)) * Affine3<T>::scale(bench_value<T>(seed + 7));
+}
+
+template <typename T>
+std::string affine_bench_name(const char* op) {
+    return std::string("Affine3<") + bench_type_name<T>() + ">/" + op;
+}
+
+// fn(a, b, a4, b4, p) runs one operation on either the Affine3 operands or their 4x4 equivalents
+template <typename T, typename F>
+void add_affine_case(const char* op, double flops, F fn) {
+    register_benchmark(affine_bench_name<T>(op), flops, 1, [fn](BenchmarkState& state) {
+        Affine3<T> a = bench_affine<T>(1);
+        Affine3<T> b = bench_affine<T>(11);
+        Matrix<T, 4, 4> a4 = a.to_matrix4();
+        Matrix<T, 4, 4> b4 = b.to_matrix4();
+        Vector<T, 3> p;
+        bench_fill(p.data.data(), 3, 21);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(a);
+            do_not_optimize(b);
+            do_not_optimize(a4);
+            do_not_optimize(b4);
+            do_not_optimize(p);
+            auto r = fn(a, b, a4, b4, p);
+            do_not_optimize(r);
+        }
+    });
+}
+
+// update(world, local, parent) recomputes every world transform once per iteration
+template <typename T, typename Transform, typename F>
+void add_scene_case(const char* op, double flops_per_node, F update) {
+    register_benchmark(affine_bench_name<T>(op), flops_per_node * SceneNodes, SceneNodes, [update](BenchmarkState& state) {
+        std::vector<Transform> local(SceneNodes), world(SceneNodes);
+        std::vector<size_t> parent(SceneNodes);
+        for (size_t n = 0; n < SceneNodes; ++n) {
+            if constexpr (std::is_same_v<Transform, Affine3<T>>)
+                local[n] = bench_affine<T>(n);
+            else
+                local[n] = bench_affine<T>(n).to_matrix4();
+            // Roughly 4-way branching tree; node 0 is the root and is its own parent
+            parent[n] = n / 4;
+        }
+        for (size_t i = 0; i < state.iterations; ++i) {
+            update(world, local, parent);
+            do_not_optimize(world[SceneNodes - 1]);
+        }
+    });
+}
+
+template <typename T>
+void register_affine_type() {
+    using A = Affine3<T>;
+    using M = Matrix<T, 4, 4>;
+    using V = Vector<T, 3>;
+    add_affine_case<T>("compose", 63, [](const A& a, const A& b, const M&, const M&, const V&) { return a * b; });
+    add_affine_case<T>("compose_mat4", 112, [](const A&, const A&, const M& a, const M& b, const V&) { return a * b; });
+    add_affine_case<T>("inverse", 0, [](const A& a, const A&, const M&, const M&, const V&) { return a.inverse(); });
+    add_affine_case<T>("inverse_mat4", 0, [](const A&, const A&, const M& a, const M&, const V&) { return a.affine_inverse(); });
+    add_affine_case<T>("rigid_inverse", 0, [](const A& a, const A&, const M&, const M&, const V&) { return a.rigid_inverse(); });
+    add_affine_case<T>("transform_point", 18, [](const A& a, const A&, const M&, const M&, const V& p) { return a.transform_point(p); });
+    add_affine_case<T>("transform_point_mat4", 28, [](const A&, const A&, const M& a, const M&, const V& p) {
+        return a.transform(Vector<T, 4>{ p[0], p[1], p[2], 1 });
+    });
+    add_affine_case<T>("transform_direction", 15, [](const A& a, const A&, const M&, const M&, const V& p) { return a.transform_direction(p); });
+
+    add_scene_case<T, A>("scene_update", 63, [](std::vector<A>& world, const std::vector<A>& local, const std::vector<size_t>& parent) {
+        world[0] = local[0];
+        for (size_t n = 1; n < local.size(); ++n)
+            world[n] = world[parent[n]] * local[n];
+    });
+    add_scene_case<T, M>("scene_update_mat4", 112, [](std::vector<M>& world, const std::vector<M>& local, const std::vector<size_t>& parent) {
+        world[0] = local[0];
+        for (size_t n = 1; n < local.size(); ++n)
+            world[n] = world[parent[n]] * local[n];
+    });
+}
+
+static const bool affine_benchmarks_registered = [] {
+    register_affine_type<float>();
+    register_affine_type<double>();
+    return true;
+}();
@@ -0,0 +1,6 @@
+#include "Benchmark.hpp"
+
+// Benchmarks register themselves from the other bench/*.cpp files at static initialization
+int main(int argc, char** argv) {
+    return run_benchmarks(argc, argv);
+}
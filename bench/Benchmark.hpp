@@ -0,0 +1,220 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../Config.hpp"
+
+// Minimal micro-benchmark harness for the bench/ suite.
+//
+// Build and run (standard library only; libstdc++ runs the parallel algorithms in ReductionBench.cpp on TBB when its
+// headers are installed, and the build then also needs -ltbb):
+//   g++ -O3 -march=native -std=c++20 -I. bench/*.cpp -o tinymath_bench -pthread
+//   ./tinymath_bench [--filter=<substring>] [--min-time=<seconds>] [--repetitions=<n>] [--json=<file>]
+//
+// Each benchmark body runs state.iterations operations; the harness grows the iteration count until one run takes
+// at least min_time, then reports the fastest of the repetitions as ns/op, items/s and GFLOP/s.
+// The JSON report is stable across runs so two releases can be diffed benchmark by benchmark.
+
+// Keeps a value alive and opaque to the optimizer, so the operation producing it cannot be removed or hoisted
+template <typename T>
+inline void do_not_optimize(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+m"(value) : : "memory");
+#else
+    const volatile char* p = reinterpret_cast<const volatile char*>(&value);
+    (void)*p;
+#endif
+}
+
+struct BenchmarkState {
+    size_t iterations = 0;
+};
+
+struct BenchmarkCase {
+    std::string name;
+    double flops_per_op = 0;   // floating-point (or integer arithmetic) operations per iteration; 0 = not reported
+    double items_per_op = 1;   // elements processed per iteration, e.g. vectors in a batch
+    std::function<void(BenchmarkState&)> body;
+};
+
+struct BenchmarkResult {
+    std::string name;
+    size_t iterations = 0;
+    double ns_per_op = 0;
+    double items_per_second = 0;
+    double gflops = 0;
+};
+
+inline std::vector<BenchmarkCase>& benchmark_registry() {
+    static std::vector<BenchmarkCase> cases;
+    return cases;
+}
+
+inline void register_benchmark(std::string name, double flops_per_op, double items_per_op, std::function<void(BenchmarkState&)> body) {
+    benchmark_registry().push_back({ std::move(name), flops_per_op, items_per_op, std::move(body) });
+}
+
+// Short type names used in benchmark names, e.g. "Vector<float,3>/dot"
+template <typename T> constexpr const char* bench_type_name() { return "?"; }
+template <> constexpr const char* bench_type_name<float>() { return "float"; }
+template <> constexpr const char* bench_type_name<double>() { return "double"; }
+template <> constexpr const char* bench_type_name<int>() { return "int"; }
+
+// Deterministic, non-trivial operand values that stay away from zero so divisions and normalizations are well defined
+template <typename T>
+inline T bench_value(size_t index) {
+    return static_cast<T>(1 + (index * 7919) % 13) / static_cast<T>(1 + index % 3);
+}
+
+// Fills count elements starting at data with bench_value, offset by seed so different operands differ
+template <typename T>
+inline void bench_fill(T* data, size_t count, size_t seed = 0) {
+    for (size_t i = 0; i < count; ++i)
+        data[i] = bench_value<T>(seed + i);
+}
+
+struct BenchmarkOptions {
+    std::string filter;
+    std::string json_path;
+    double min_time = 0.1;
+    int repetitions = 3;
+};
+
+inline double run_once(const BenchmarkCase& bench, size_t iterations) {
+    BenchmarkState state{ iterations };
+    const auto start = std::chrono::steady_clock::now();
+    bench.body(state);
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+inline BenchmarkResult run_benchmark(const BenchmarkCase& bench, const BenchmarkOptions& options) {
+    // Grow the iteration count until a single run is long enough to time reliably
+    size_t iterations = 1;
+    double seconds = run_once(bench, iterations);
+    while (seconds < options.min_time && iterations < (size_t(1) << 40)) {
+        const double scale = seconds > 0 ? std::min(10.0, 1.4 * options.min_time / seconds) : 10.0;
+        iterations = std::max(iterations + 1, static_cast<size_t>(iterations * scale));
+        seconds = run_once(bench, iterations);
+    }
+    for (int r = 1; r < options.repetitions; ++r)
+        seconds = std::min(seconds, run_once(bench, iterations));
+
+    BenchmarkResult result;
+    result.name = bench.name;
+    result.iterations = iterations;
+    result.ns_per_op = seconds * 1e9 / iterations;
+    result.items_per_second = bench.items_per_op * iterations / seconds;
+    result.gflops = bench.flops_per_op * iterations / seconds * 1e-9;
+    return result;
+}
+
+inline std::string json_escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+inline void write_json(std::FILE* file, const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options) {
+#if defined(__clang__)
+    const char* compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    const char* compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    const char* compiler = "msvc";
+#else
+    const char* compiler = "unknown";
+#endif
+#if defined(TINYMATH_SIMD_AVX)
+    const char* simd = "avx";
+#elif defined(TINYMATH_SIMD_SSE)
+    const char* simd = "sse";
+#else
+    const char* simd = "none";
+#endif
+#if defined(TINYMATH_FMA)
+    const bool fma = true;
+#else
+    const bool fma = false;
+#endif
+    std::fprintf(file, "{\n  \"context\": {\n");
+    std::fprintf(file, "    \"compiler\": \"%s\",\n", json_escape(compiler).c_str());
+    std::fprintf(file, "    \"simd\": \"%s\",\n    \"fma\": %s,\n", simd, fma ? "true" : "false");
+    std::fprintf(file, "    \"min_time\": %g,\n    \"repetitions\": %d\n  },\n", options.min_time, options.repetitions);
+    std::fprintf(file, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        std::fprintf(file, "    { \"name\": \"%s\", \"iterations\": %zu, \"ns_per_op\": %.4f, \"items_per_second\": %.6g, \"gflops\": %.4f }%s\n",
+                     json_escape(r.name).c_str(), r.iterations, r.ns_per_op, r.items_per_second, r.gflops,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+}
+
+inline bool parse_benchmark_options(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&](const char* prefix) -> const char* {
+            const size_t length = std::strlen(prefix);
+            return arg.compare(0, length, prefix) == 0 ? argv[i] + length : nullptr;
+        };
+        if (const char* v = value("--filter="))
+            options.filter = v;
+        else if (const char* v = value("--json="))
+            options.json_path = v;
+        else if (const char* v = value("--min-time="))
+            options.min_time = std::atof(v);
+        else if (const char* v = value("--repetitions="))
+            options.repetitions = std::max(1, std::atoi(v));
+        else {
+            std::fprintf(stderr, "usage: %s [--filter=<substring>] [--min-time=<seconds>] [--repetitions=<n>] [--json=<file>]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Runs every registered benchmark whose name contains the filter, printing a table and optionally writing JSON
+inline int run_benchmarks(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parse_benchmark_options(argc, argv, options))
+        return 1;
+
+    std::vector<BenchmarkCase> cases = benchmark_registry();
+    std::stable_sort(cases.begin(), cases.end(), [](const BenchmarkCase& a, const BenchmarkCase& b) { return a.name < b.name; });
+
+    std::vector<BenchmarkResult> results;
+    std::printf("%-48s %14s %14s %14s %10s\n", "Benchmark", "Iterations", "ns/op", "items/s", "GFLOP/s");
+    for (const BenchmarkCase& bench : cases) {
+        if (!options.filter.empty() && bench.name.find(options.filter) == std::string::npos)
+            continue;
+        const BenchmarkResult r = run_benchmark(bench, options);
+        std::printf("%-48s %14zu %14.3f %14.4g %10.3f\n", r.name.c_str(), r.iterations, r.ns_per_op, r.items_per_second, r.gflops);
+        std::fflush(stdout);
+        results.push_back(r);
+    }
+
+    if (!options.json_path.empty()) {
+        std::FILE* file = options.json_path == "-" ? stdout : std::fopen(options.json_path.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "cannot open %s\n", options.json_path.c_str());
+            return 1;
+        }
+        write_json(file, results, options);
+        if (file != stdout)
+            std::fclose(file);
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../MatrixBatch.hpp"
+
+// Small linear systems: one factorization and solve per call, and the batched solvers over BatchSystems systems.
+// Every case solves BatchSystems systems per iteration, so items/s is systems per second throughout.
+
+constexpr size_t BatchSystems = 4096;
+
+// Diagonally dominant symmetric matrix: invertible and positive definite, so every solver applies
+template <typename T, int N>
+Matrix<T, N, N> decomposition_bench_matrix(size_t seed) {
+    Matrix<T, N, N> m;
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j <= i; ++j)
+            m[i][j] = m[j][i] = bench_value<T>(seed + i * N + j) / (4 * N);
+        m[i][i] += 4;
+    }
+    return m;
+}
+
+template <typename T, int N>
+std::string decomposition_bench_name(const char* op) {
+    return std::string("Decomposition<") + bench_type_name<T>() + "," + std::to_string(N) + ">/" + op;
+}
+
+template <typename T, int N, typename F>
+void add_single_solve_case(const char* op, F solve) {
+    register_benchmark(decomposition_bench_name<T, N>(op), 0, BatchSystems, [solve](BenchmarkState& state) {
+        std::vector<Matrix<T, N, N>> a(BatchSystems);
+        std::vector<Vector<T, N>> b(BatchSystems), x(BatchSystems);
+        for (size_t s = 0; s < BatchSystems; ++s) {
+            a[s] = decomposition_bench_matrix<T, N>(s);
+            bench_fill(b[s].data.data(), N, s);
+        }
+        for (size_t i = 0; i < state.iterations; ++i) {
+            for (size_t s = 0; s < BatchSystems; ++s)
+                x[s] = solve(a[s], b[s]);
+            do_not_optimize(x[0]);
+        }
+    });
+}
+
+template <typename T, int N, typename F>
+void add_batch_solve_case(const char* op, F solve_batch) {
+    register_benchmark(decomposition_bench_name<T, N>(op), 0, BatchSystems, [solve_batch](BenchmarkState& state) {
+        MatrixBatch<T, N, N> source(BatchSystems), a;
+        VectorBatch<T, N> rhs(BatchSystems), b;
+        for (size_t s = 0; s < BatchSystems; ++s) {
+            source.set(s, decomposition_bench_matrix<T, N>(s));
+            Vector<T, N> v;
+            bench_fill(v.data.data(), N, s);
+            rhs.set(s, v);
+        }
+        for (size_t i = 0; i < state.iterations; ++i) {
+            // The solvers work in place, so each iteration starts from a fresh copy (included in the timing)
+            a = source;
+            b = rhs;
+            solve_batch(a, b);
+            do_not_optimize(b.lane(0)[0]);
+        }
+    });
+}
+
+template <typename T, int N>
+void register_decomposition_size() {
+    using M = Matrix<T, N, N>;
+    using V = Vector<T, N>;
+    add_single_solve_case<T, N>("lu_solve", [](const M& a, const V& b) { return a.lu().solve(b); });
+    add_single_solve_case<T, N>("qr_solve", [](const M& a, const V& b) { return a.qr().solve(b); });
+    add_single_solve_case<T, N>("cholesky_solve", [](const M& a, const V& b) { return a.cholesky().solve(b); });
+    add_batch_solve_case<T, N>("lu_solve_batch", [](MatrixBatch<T, N, N>& a, VectorBatch<T, N>& b) { lu_solve_batch(a, b, false); });
+    add_batch_solve_case<T, N>("cholesky_solve_batch", [](MatrixBatch<T, N, N>& a, VectorBatch<T, N>& b) { cholesky_solve_batch(a, b, false); });
+}
+
+template <typename T>
+void register_decomposition_type() {
+    register_decomposition_size<T, 3>();
+    register_decomposition_size<T, 4>();
+    register_decomposition_size<T, 6>();
+}
+
+static const bool decomposition_benchmarks_registered = [] {
+    register_decomposition_type<float>();
+    register_decomposition_type<double>();
+    return true;
+}();
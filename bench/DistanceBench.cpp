@@ -0,0 +1,77 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../DistanceMatrix.hpp"
+
+// distance_matrix and distance_squared_matrix between two sets of random points, against the double loops over
+// Vector::distance and Vector::distance_squared that fill the same matrix. Whether a case takes the GEMM path depends
+// on TINYMATH_DISTANCE_GEMM_MIN_DIM. Everything runs single-threaded; items/s counts point pairs.
+
+template <typename T, int N>
+std::vector<Vector<T, N>> distance_bench_points(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coordinate(-1, 1);
+    std::vector<Vector<T, N>> points(count);
+    for (auto& p : points) {
+        for (int c = 0; c < N; ++c)
+            p[c] = static_cast<T>(coordinate(rng));
+    }
+    return points;
+}
+
+template <typename T, int N>
+void register_distance_size(int count) {
+    using V = Vector<T, N>;
+    using Span = std::span<const V>;
+    const std::string name = std::string("Distance<") + bench_type_name<T>() + "," + std::to_string(N) + ">/" + std::to_string(count) + "x" + std::to_string(count) + "/";
+    const double pairs = double(count) * count;
+    auto add = [&](const char* op, auto fn) {
+        register_benchmark(name + op, 3.0 * N * pairs, pairs, [count, fn](BenchmarkState& state) {
+            const std::vector<V> a = distance_bench_points<T, N>(count, 1);
+            const std::vector<V> b = distance_bench_points<T, N>(count, 2);
+            DynMatrix<T> out(count, count);
+            for (size_t i = 0; i < state.iterations; ++i) {
+                fn(Span(a), Span(b), out);
+                do_not_optimize(out.data()[0]);
+            }
+        });
+    };
+    add("distance_matrix", [](Span a, Span b, DynMatrix<T>& out) { distance_matrix_into<true>(a, b, out.view(), false); });
+    add("distance_squared_matrix", [](Span a, Span b, DynMatrix<T>& out) { distance_matrix_into<false>(a, b, out.view(), false); });
+    add("distance_loop", [](Span a, Span b, DynMatrix<T>& out) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            for (size_t j = 0; j < b.size(); ++j)
+                out[i][j] = V::distance(a[i], b[j]);
+        }
+    });
+    add("distance_squared_loop", [](Span a, Span b, DynMatrix<T>& out) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            for (size_t j = 0; j < b.size(); ++j)
+                out[i][j] = V::distance_squared(a[i], b[j]);
+        }
+    });
+}
+
+template <typename T, int N>
+void register_distance_type() {
+    for (int count : { 64, 512, 2048 })
+        register_distance_size<T, N>(count);
+}
+
+static const bool distance_benchmarks_registered = [] {
+    register_distance_type<float, 2>();
+    register_distance_type<float, 3>();
+    register_distance_type<float, 4>();
+    register_distance_type<float, 8>();
+    register_distance_type<float, 16>();
+    register_distance_type<float, 32>();
+    register_distance_type<float, 64>();
+    register_distance_type<float, 128>();
+    register_distance_type<double, 3>();
+    register_distance_type<double, 16>();
+    register_distance_type<double, 64>();
+    register_distance_type<double, 128>();
+    return true;
+}();
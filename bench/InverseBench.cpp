@@ -0,0 +1,119 @@
+#include <cmath>
+#include <string>
+#include <utility>
+#include "Benchmark.hpp"
+#include "../Matrix.hpp"
+
+// Closed-form determinant/inverse against a generic Gauss-Jordan elimination with partial pivoting,
+// the approach these specializations replace for small matrices.
+
+template <typename T, int N>
+Matrix<T, N, N> gauss_jordan_inverse(Matrix<T, N, N> a) {
+    Matrix<T, N, N> inv;
+    for (int i = 0; i < N; ++i)
+        inv[i][i] = 1;
+    for (int col = 0; col < N; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < N; ++row) {
+            if (std::abs(a[row][col]) > std::abs(a[pivot][col]))
+                pivot = row;
+        }
+        std::swap(a[col], a[pivot]);
+        std::swap(inv[col], inv[pivot]);
+        const T scale = 1 / a[col][col];
+        for (int j = 0; j < N; ++j) {
+            a[col][j] *= scale;
+            inv[col][j] *= scale;
+        }
+        for (int row = 0; row < N; ++row) {
+            if (row == col)
+                continue;
+            const T factor = a[row][col];
+            for (int j = 0; j < N; ++j) {
+                a[row][j] -= factor * a[col][j];
+                inv[row][j] -= factor * inv[col][j];
+            }
+        }
+    }
+    return inv;
+}
+
+template <typename T, int N>
+T gauss_determinant(Matrix<T, N, N> a) {
+    T det = 1;
+    for (int col = 0; col < N; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < N; ++row) {
+            if (std::abs(a[row][col]) > std::abs(a[pivot][col]))
+                pivot = row;
+        }
+        if (pivot != col) {
+            std::swap(a[col], a[pivot]);
+            det = -det;
+        }
+        det *= a[col][col];
+        for (int row = col + 1; row < N; ++row) {
+            const T factor = a[row][col] / a[col][col];
+            for (int j = col; j < N; ++j)
+                a[row][j] -= factor * a[col][j];
+        }
+    }
+    return det;
+}
+
+// Well-conditioned operand: a rigid transform (rotation about a skewed axis plus translation) for N >= 3
+template <typename T, int N>
+Matrix<T, N, N> inverse_bench_matrix() {
+    Matrix<T, N, N> m;
+    const T c = std::cos(T(0.7)), s = std::sin(T(0.7));
+    for (int i = 0; i < N; ++i)
+        m[i][i] = 1;
+    m[0][0] = c;
+    m[0][1] = -s;
+    m[1][0] = s;
+    m[1][1] = c;
+    if constexpr (N >= 3) {
+        for (int i = 0; i < N - 1; ++i)
+            m[i][N - 1] = bench_value<T>(i);
+    }
+    return m;
+}
+
+template <typename T, int N, typename F>
+void add_inverse_case(const char* op, F fn) {
+    const std::string name = std::string("Matrix<") + bench_type_name<T>() + "," + std::to_string(N) + "x" + std::to_string(N) + ">/" + op;
+    register_benchmark(name, 0, 1, [fn](BenchmarkState& state) {
+        Matrix<T, N, N> m = inverse_bench_matrix<T, N>();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(m);
+            auto r = fn(m);
+            do_not_optimize(r);
+        }
+    });
+}
+
+template <typename T, int N>
+void register_inverse_size() {
+    using M = Matrix<T, N, N>;
+    add_inverse_case<T, N>("determinant", [](const M& m) { return m.determinant(); });
+    add_inverse_case<T, N>("determinant_gauss", [](const M& m) { return gauss_determinant(m); });
+    add_inverse_case<T, N>("inverse", [](const M& m) { return m.inverse(); });
+    add_inverse_case<T, N>("inverse_gauss", [](const M& m) { return gauss_jordan_inverse(m); });
+    if constexpr (N >= 3) {
+        add_inverse_case<T, N>("affine_inverse", [](const M& m) { return m.affine_inverse(); });
+        add_inverse_case<T, N>("rigid_inverse", [](const M& m) { return m.rigid_inverse(); });
+    }
+}
+
+template <typename T>
+void register_inverse_type() {
+    register_inverse_size<T, 2>();
+    register_inverse_size<T, 3>();
+    register_inverse_size<T, 4>();
+}
+
+static const bool inverse_benchmarks_registered = [] {
+    register_inverse_type<float>();
+    register_inverse_type<double>();
+    return true;
+}();
@@ -0,0 +1,236 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../Matrix.hpp"
+#include "../ThreadPool.hpp"
+
+// Every public Matrix operation for float, double and int on square sizes 2, 3, 4, 8, 16 and 64, plus the
+// ColumnMajor product and transform against the row-major default, and matrix-vector products on the non-square
+// shapes of small least-squares problems, and the blocked GEMM against the naive triple loop at 64, 128 and 256.
+// Batch transforms and products run single-threaded so the numbers measure the kernel, not the pool.
+
+constexpr size_t BatchSize = 1024;
+
+template <typename T, int N>
+Matrix<T, N, N> bench_matrix(size_t seed) {
+    Matrix<T, N, N> m;
+    bench_fill(m.data[0].data(), N * N, seed);
+    return m;
+}
+
+template <typename T, int N>
+std::string matrix_bench_name(const char* op) {
+    return std::string("Matrix<") + bench_type_name<T>() + "," + std::to_string(N) + "x" + std::to_string(N) + ">/" + op;
+}
+
+// Operands use the given layout, holding the same values in either case
+template <typename T, int N, typename Layout = RowMajor, typename F>
+void add_matrix_case(const char* op, double flops, F fn) {
+    register_benchmark(matrix_bench_name<T, N>(op), flops, 1, [fn](BenchmarkState& state) {
+        Matrix<T, N, N, Layout> a(bench_matrix<T, N>(1));
+        Matrix<T, N, N, Layout> b(bench_matrix<T, N>(7));
+        Vector<T, N> v;
+        bench_fill(v.data.data(), N, 3);
+        T s = bench_value<T>(3);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(a);
+            do_not_optimize(b);
+            do_not_optimize(v);
+            do_not_optimize(s);
+            auto r = fn(a, b, v, s);
+            do_not_optimize(r);
+        }
+    });
+}
+
+template <typename T, int N>
+void register_matrix_batch_cases() {
+    constexpr double flops = 2.0 * N * N * BatchSize;
+    register_benchmark(matrix_bench_name<T, N>("transform_batch"), flops, BatchSize, [](BenchmarkState& state) {
+        Matrix<T, N, N> m = bench_matrix<T, N>(1);
+        std::vector<Vector<T, N>> in(BatchSize), out(BatchSize);
+        bench_fill(in[0].data.data(), N * BatchSize, 5);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(m);
+            m.transform_batch(std::span<const Vector<T, N>>(in), std::span<Vector<T, N>>(out), false);
+            do_not_optimize(out[0]);
+        }
+    });
+    register_benchmark(matrix_bench_name<T, N>("transform_batch_soa"), flops, BatchSize, [](BenchmarkState& state) {
+        Matrix<T, N, N> m = bench_matrix<T, N>(1);
+        VectorBatch<T, N> in(BatchSize), out(BatchSize);
+        for (int j = 0; j < N; ++j)
+            bench_fill(in.lane(j), BatchSize, 5 + j);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(m);
+            m.transform_batch(in, out, false);
+            do_not_optimize(out.lane(0)[0]);
+        }
+    });
+}
+
+template <typename T, int N>
+void register_matrix_size() {
+    using M = Matrix<T, N, N>;
+    using V = Vector<T, N>;
+    constexpr double n2 = double(N) * N;
+    constexpr double n3 = n2 * N;
+
+    // Element-wise matrix operations and products
+    add_matrix_case<T, N>("add", n2, [](const M& a, const M& b, const V&, T) { return a + b; });
+    add_matrix_case<T, N>("sub", n2, [](const M& a, const M& b, const V&, T) { return a - b; });
+    add_matrix_case<T, N>("mul", 2 * n3, [](const M& a, const M& b, const V&, T) { return a * b; });
+    // ExactAccumulation runs the sequential i-j-k loop, so below TINYMATH_GEMM_BLOCKED_MIN_DIM mul against mul_exact
+    // is the fused loop against the naive one; the blocked kernel is compared in register_matrix_gemm_size
+    add_matrix_case<T, N>("mul_exact", 2 * n3, [](const M& a, const M& b, const V&, T) { return a.template multiply<ExactAccumulation>(b); });
+    add_matrix_case<T, N>("add_assign", n2, [](M a, const M& b, const V&, T) { return a += b; });
+    add_matrix_case<T, N>("sub_assign", n2, [](M a, const M& b, const V&, T) { return a -= b; });
+    add_matrix_case<T, N>("mul_assign", 2 * n3, [](M a, const M& b, const V&, T) { return a *= b; });
+
+    // Scalar operations
+    add_matrix_case<T, N>("add_scalar", n2, [](const M& a, const M&, const V&, T s) { return a + s; });
+    add_matrix_case<T, N>("sub_scalar", n2, [](const M& a, const M&, const V&, T s) { return a - s; });
+    add_matrix_case<T, N>("mul_scalar", n2, [](const M& a, const M&, const V&, T s) { return a * s; });
+    add_matrix_case<T, N>("div_scalar", n2, [](const M& a, const M&, const V&, T s) { return a / s; });
+    add_matrix_case<T, N>("add_scalar_assign", n2, [](M a, const M&, const V&, T s) { return a += s; });
+    add_matrix_case<T, N>("sub_scalar_assign", n2, [](M a, const M&, const V&, T s) { return a -= s; });
+    add_matrix_case<T, N>("mul_scalar_assign", n2, [](M a, const M&, const V&, T s) { return a *= s; });
+    add_matrix_case<T, N>("div_scalar_assign", n2, [](M a, const M&, const V&, T s) { return a /= s; });
+
+    // Utilities
+    add_matrix_case<T, N>("transpose", 0, [](const M& a, const M&, const V&, T) { return a.transpose(); });
+    add_matrix_case<T, N>("transform", 2 * n2, [](const M& a, const M&, const V& v, T) { return a.transform(v); });
+    add_matrix_case<T, N>("transform_exact", 2 * n2, [](const M& a, const M&, const V& v, T) { return a.template transform<ExactAccumulation>(v); });
+    add_matrix_case<T, N>("transpose_multiply", 2 * n2, [](const M& a, const M&, const V& v, T) { return a.transpose_multiply(v); });
+    add_matrix_case<T, N>("lazy_axpy", 2 * n2, [](const M& a, const M& b, const V&, T s) { return M(lazy(a) * s + lazy(b)); });
+    // a * s + b - b * s + a, with a temporary per operator eagerly and a single pass with lazy()
+    add_matrix_case<T, N>("chain", 6 * n2, [](const M& a, const M& b, const V&, T s) { return a * s + b - b * s + a; });
+    add_matrix_case<T, N>("lazy_chain", 6 * n2, [](const M& a, const M& b, const V&, T s) {
+        return M(lazy(a) * s + lazy(b) - lazy(b) * s + lazy(a));
+    });
+
+    // Column-major storage, and the conversion it saves before a column-major upload
+    using CM = Matrix<T, N, N, ColumnMajor>;
+    add_matrix_case<T, N, ColumnMajor>("mul_column_major", 2 * n3, [](const CM& a, const CM& b, const V&, T) { return a * b; });
+    add_matrix_case<T, N, ColumnMajor>("transform_column_major", 2 * n2, [](const CM& a, const CM&, const V& v, T) { return a.transform(v); });
+    add_matrix_case<T, N>("to_column_major", 0, [](const M& a, const M&, const V&, T) { return CM(a); });
+    register_matrix_batch_cases<T, N>();
+
+    // Operators
+    add_matrix_case<T, N>("equal", 0, [](const M& a, const M& b, const V&, T) { return a == b; });
+    add_matrix_case<T, N>("not_equal", 0, [](const M& a, const M& b, const V&, T) { return a != b; });
+    add_matrix_case<T, N>("subscript", 0, [](const M& a, const M&, const V&, T) { return a[N - 1][N - 1]; });
+}
+
+// The naive i-j-k triple loop Matrix::multiply ran before the blocked GEMM
+template <typename T, int N>
+void naive_multiply(const Matrix<T, N, N>& a, const Matrix<T, N, N>& b, Matrix<T, N, N>& out) {
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
+            T sum = 0;
+            for (int k = 0; k < N; ++k)
+                sum += a[i][k] * b[k][j];
+            out[i][j] = sum;
+        }
+    }
+}
+
+// mul_blocked is Matrix::multiply on the blocked GEMM path, mul_naive the loop it replaced. Operands live on the
+// heap, and the product runs on a one-thread pool so both cases use a single core.
+template <typename T, int N>
+void register_matrix_gemm_size() {
+    using M = Matrix<T, N, N>;
+    static_assert(N >= TINYMATH_GEMM_BLOCKED_MIN_DIM, "Size must take the blocked path.");
+    constexpr double flops = 2.0 * N * N * N;
+    auto add = [](const char* op, auto fn) {
+        register_benchmark(matrix_bench_name<T, N>(op), flops, 1, [fn](BenchmarkState& state) {
+            auto a = std::make_unique<M>(), b = std::make_unique<M>(), out = std::make_unique<M>();
+            bench_fill(a->data[0].data(), N * N, 1);
+            bench_fill(b->data[0].data(), N * N, 7);
+            ThreadPool serial(1);
+            ThreadPool::set_current(&serial);
+            for (size_t i = 0; i < state.iterations; ++i) {
+                do_not_optimize(*a);
+                fn(*a, *b, *out);
+                do_not_optimize(*out);
+            }
+            ThreadPool::set_current(nullptr);
+        });
+    };
+    add("mul_blocked", [](const M& a, const M& b, M& out) { out = a * b; });
+    add("mul_naive", [](const M& a, const M& b, M& out) { naive_multiply(a, b, out); });
+}
+
+// A (R x C) * x and A^T * y; the _exact cases are the sequential scalar loops and transpose_transform builds A^T
+// first, as callers had to before transpose_multiply
+template <typename T, int R, int C, typename Layout = RowMajor>
+void register_matrix_vector_shape(const char* suffix = "") {
+    using M = Matrix<T, R, C, Layout>;
+    const std::string name = std::string("Matrix<") + bench_type_name<T>() + "," + std::to_string(R) + "x" + std::to_string(C) + ">/";
+    constexpr double flops = 2.0 * R * C;
+    auto add = [&](const char* op, auto fn) {
+        register_benchmark(name + op + suffix, flops, 1, [fn](BenchmarkState& state) {
+            M a;
+            for (int i = 0; i < R; ++i) {
+                for (int j = 0; j < C; ++j)
+                    a(i, j) = bench_value<T>(i * C + j);
+            }
+            Vector<T, C> x;
+            Vector<T, R> y;
+            bench_fill(x.data.data(), C, 3);
+            bench_fill(y.data.data(), R, 5);
+            for (size_t i = 0; i < state.iterations; ++i) {
+                do_not_optimize(a);
+                do_not_optimize(x);
+                do_not_optimize(y);
+                auto r = fn(a, x, y);
+                do_not_optimize(r);
+            }
+        });
+    };
+    add("matvec", [](const M& a, const Vector<T, C>& x, const Vector<T, R>&) { return a * x; });
+    add("matvec_exact", [](const M& a, const Vector<T, C>& x, const Vector<T, R>&) { return a.template transform<ExactAccumulation>(x); });
+    add("transpose_multiply", [](const M& a, const Vector<T, C>&, const Vector<T, R>& y) { return a.transpose_multiply(y); });
+    add("transpose_multiply_exact", [](const M& a, const Vector<T, C>&, const Vector<T, R>& y) { return a.template transpose_multiply<ExactAccumulation>(y); });
+    add("transpose_transform", [](const M& a, const Vector<T, C>&, const Vector<T, R>& y) { return a.transpose().transform(y); });
+}
+
+template <typename T>
+void register_matrix_vector_type() {
+    register_matrix_vector_shape<T, 3, 4>();
+    register_matrix_vector_shape<T, 4, 3>();
+    register_matrix_vector_shape<T, 6, 6>();
+    register_matrix_vector_shape<T, 32, 6>();
+    register_matrix_vector_shape<T, 6, 32>();
+    register_matrix_vector_shape<T, 100, 8>();
+    register_matrix_vector_shape<T, 100, 8, ColumnMajor>("_column_major");
+}
+
+template <typename T>
+void register_matrix_type() {
+    register_matrix_size<T, 2>();
+    register_matrix_size<T, 3>();
+    register_matrix_size<T, 4>();
+    register_matrix_size<T, 8>();
+    register_matrix_size<T, 16>();
+    register_matrix_size<T, 64>();
+}
+
+template <typename T>
+void register_matrix_gemm_type() {
+    register_matrix_gemm_size<T, 64>();
+    register_matrix_gemm_size<T, 128>();
+    register_matrix_gemm_size<T, 256>();
+}
+
+static const bool matrix_benchmarks_registered = [] {
+    register_matrix_type<float>();
+    register_matrix_type<double>();
+    register_matrix_type<int>();
+    register_matrix_vector_type<float>();
+    register_matrix_vector_type<double>();
+    register_matrix_gemm_type<float>();
+    register_matrix_gemm_type<double>();
+    return true;
+}();
@@ -0,0 +1,147 @@
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../PointIndex.hpp"
+
+// PointIndex build and queries on uniformly random points against brute-force scans calling Vector::distance for
+// every candidate, which is how callers answered the same queries before. Radius queries use a radius that holds
+// about 16 points on average. Queries run single-threaded in batches of QueryCount; items/s counts queries, or
+// points for build.
+
+constexpr size_t QueryCount = 256;
+constexpr size_t QueryNeighbors = 8;
+
+// The points, the queries and the index, created on first use so filtered-out sizes never build anything
+template <typename T, int N>
+struct PointIndexBenchData {
+    std::vector<Vector<T, N>> points;
+    std::vector<Vector<T, N>> queries;
+    PointIndex<T, N> index;
+    T radius = 0;
+};
+
+// Uniform in the unit cube; bench_fill repeats too few values to make a sensible point cloud
+template <typename T, int N>
+std::vector<Vector<T, N>> random_points(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coordinate(0, 1);
+    std::vector<Vector<T, N>> points(count);
+    for (auto& p : points) {
+        for (int c = 0; c < N; ++c)
+            p[c] = static_cast<T>(coordinate(rng));
+    }
+    return points;
+}
+
+template <typename T, int N>
+void register_point_index_size(size_t count) {
+    using V = Vector<T, N>;
+    using Data = PointIndexBenchData<T, N>;
+    using Neighbor = typename PointIndex<T, N>::Neighbor;
+    const std::string name = std::string("PointIndex<") + bench_type_name<T>() + "," + std::to_string(N) + ">/" + std::to_string(count) + "/";
+    auto data = std::make_shared<Data>();
+    auto prepare = [data, count]() -> Data& {
+        if (data->points.empty()) {
+            data->points = random_points<T, N>(count, 1);
+            data->queries = random_points<T, N>(QueryCount, 2);
+            data->index.build(std::span<const V>(data->points));
+            // Radius of the ball whose share of the unit cube is 16 / count points: (16 / count / unit ball)^(1/N)
+            const double unit_ball = std::pow(3.14159265358979, N / 2.0) / std::tgamma(N / 2.0 + 1);
+            data->radius = static_cast<T>(std::pow(16.0 / count / unit_ball, 1.0 / N));
+        }
+        return *data;
+    };
+    auto add = [&](const char* op, double items, auto fn) {
+        register_benchmark(name + op, 0, items, [prepare, fn](BenchmarkState& state) {
+            Data& d = prepare();
+            for (size_t i = 0; i < state.iterations; ++i) {
+                auto r = fn(d);
+                do_not_optimize(r);
+            }
+        });
+    };
+
+    add("build", count, [](Data& d) {
+        PointIndex<T, N> index(std::span<const V>(d.points));
+        return index.size();
+    });
+
+    add("nearest", QueryCount, [](Data& d) {
+        size_t sum = 0;
+        for (const V& q : d.queries)
+            sum += d.index.nearest(q).index;
+        return sum;
+    });
+    add("nearest_brute", QueryCount, [](Data& d) {
+        size_t sum = 0;
+        for (const V& q : d.queries) {
+            size_t best = 0;
+            T best_distance = V::distance(q, d.points[0]);
+            for (size_t i = 1; i < d.points.size(); ++i) {
+                const T distance = V::distance(q, d.points[i]);
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best = i;
+                }
+            }
+            sum += best;
+        }
+        return sum;
+    });
+
+    add("nearest_8", QueryCount, [](Data& d) {
+        std::vector<Neighbor> out(QueryCount * QueryNeighbors);
+        d.index.nearest_batch(std::span<const V>(d.queries), QueryNeighbors, std::span<Neighbor>(out), false);
+        return out[0].index;
+    });
+    add("nearest_8_brute", QueryCount, [](Data& d) {
+        size_t sum = 0;
+        for (const V& q : d.queries) {
+            // Sorted insertion into the k best, the same bookkeeping the index does
+            Neighbor best[QueryNeighbors] = {};
+            size_t found = 0;
+            for (size_t i = 0; i < d.points.size(); ++i) {
+                const T distance = V::distance(q, d.points[i]);
+                if (found == QueryNeighbors && !(distance < best[QueryNeighbors - 1].distance_squared))
+                    continue;
+                size_t j = found < QueryNeighbors ? found++ : QueryNeighbors - 1;
+                for (; j > 0 && distance < best[j - 1].distance_squared; --j)
+                    best[j] = best[j - 1];
+                best[j] = { i, distance };
+            }
+            sum += best[0].index;
+        }
+        return sum;
+    });
+
+    add("within_radius", QueryCount, [](Data& d) {
+        auto result = d.index.within_radius_batch(std::span<const V>(d.queries), d.radius, false);
+        return result[0].size();
+    });
+    add("within_radius_brute", QueryCount, [](Data& d) {
+        std::vector<std::vector<size_t>> result(d.queries.size());
+        for (size_t q = 0; q < d.queries.size(); ++q) {
+            for (size_t i = 0; i < d.points.size(); ++i) {
+                if (V::distance(d.queries[q], d.points[i]) <= d.radius)
+                    result[q].push_back(i);
+            }
+        }
+        return result[0].size();
+    });
+}
+
+template <typename T, int N>
+void register_point_index_type() {
+    for (size_t count : { size_t(1) << 10, size_t(1) << 16, size_t(1) << 20 })
+        register_point_index_size<T, N>(count);
+}
+
+static const bool point_index_benchmarks_registered = [] {
+    register_point_index_type<float, 2>();
+    register_point_index_type<float, 3>();
+    register_point_index_type<double, 3>();
+    return true;
+}();
@@ -0,0 +1,102 @@
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../Quaternion.hpp"
+
+// Quaternion operations, and rotation of Vector<T, 3> batches against the per-vector mat3x3 path
+// (convert to a matrix, then Matrix::transform for every vector).
+
+constexpr size_t RotateBatchSize = 4096;
+
+template <typename T>
+Quaternion<T> bench_quaternion(size_t seed) {
+    Vector<T, 3> axis;
+    bench_fill(axis.data.data(), 3, seed);
+    return Quaternion<T>::from_axis_angle(axis.normalized(), bench_value<T>(seed + 3));
+}
+
+template <typename T>
+std::string quaternion_bench_name(const char* op) {
+    return std::string("Quaternion<") + bench_type_name<T>() + ">/" + op;
+}
+
+template <typename T, typename F>
+void add_quaternion_case(const char* op, double flops, F fn) {
+    register_benchmark(quaternion_bench_name<T>(op), flops, 1, [fn](BenchmarkState& state) {
+        Quaternion<T> a = bench_quaternion<T>(1);
+        Quaternion<T> b = bench_quaternion<T>(5);
+        Vector<T, 3> v;
+        bench_fill(v.data.data(), 3, 9);
+        T t = T(0.3);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(a);
+            do_not_optimize(b);
+            do_not_optimize(v);
+            do_not_optimize(t);
+            auto r = fn(a, b, v, t);
+            do_not_optimize(r);
+        }
+    });
+}
+
+// fn(q, in, out) rotates RotateBatchSize vectors per iteration
+template <typename T, typename F>
+void add_rotate_batch_case(const char* op, F fn) {
+    register_benchmark(quaternion_bench_name<T>(op), 15.0 * RotateBatchSize, RotateBatchSize, [fn](BenchmarkState& state) {
+        Quaternion<T> q = bench_quaternion<T>(1);
+        std::vector<Vector<T, 3>> in(RotateBatchSize), out(RotateBatchSize);
+        bench_fill(in[0].data.data(), 3 * RotateBatchSize, 5);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(q);
+            fn(q, in, out);
+            do_not_optimize(out[0]);
+        }
+    });
+}
+
+template <typename T>
+void register_quaternion_type() {
+    using Q = Quaternion<T>;
+    using V = Vector<T, 3>;
+    add_quaternion_case<T>("multiply", 28, [](const Q& a, const Q& b, const V&, T) { return a * b; });
+    add_quaternion_case<T>("multiply_mat3", 45, [](const Q& a, const Q& b, const V&, T) { return a.to_matrix3() * b.to_matrix3(); });
+    add_quaternion_case<T>("normalized", 13, [](const Q& a, const Q&, const V&, T) { return a.normalized(); });
+    add_quaternion_case<T>("rotate", 30, [](const Q& a, const Q&, const V& v, T) { return a.rotate(v); });
+    add_quaternion_case<T>("rotate_mat3", 15, [](const Q& a, const Q&, const V& v, T) { return a.to_matrix3().transform(v); });
+    add_quaternion_case<T>("to_matrix3", 0, [](const Q& a, const Q&, const V&, T) { return a.to_matrix3(); });
+    add_quaternion_case<T>("to_matrix4", 0, [](const Q& a, const Q&, const V&, T) { return a.to_matrix4(); });
+    add_quaternion_case<T>("from_matrix3", 0, [](const Q& a, const Q&, const V&, T) { return Q::from_matrix(a.to_matrix3()); });
+    add_quaternion_case<T>("nlerp", 0, [](const Q& a, const Q& b, const V&, T t) { return Q::nlerp(a, b, t); });
+    add_quaternion_case<T>("slerp", 0, [](const Q& a, const Q& b, const V&, T t) { return Q::slerp(a, b, t); });
+
+    // The matrix path the batch replaces: one matrix conversion, then one transform call per vector
+    add_rotate_batch_case<T>("rotate_batch_mat3_loop", [](const Q& q, const std::vector<V>& in, std::vector<V>& out) {
+        const Matrix<T, 3, 3> m = q.to_matrix3();
+        for (size_t n = 0; n < in.size(); ++n)
+            out[n] = m.transform(in[n]);
+    });
+    add_rotate_batch_case<T>("rotate_loop", [](const Q& q, const std::vector<V>& in, std::vector<V>& out) {
+        for (size_t n = 0; n < in.size(); ++n)
+            out[n] = q.rotate(in[n]);
+    });
+    add_rotate_batch_case<T>("rotate_batch", [](const Q& q, const std::vector<V>& in, std::vector<V>& out) {
+        q.rotate_batch(std::span<const V>(in), std::span<V>(out), false);
+    });
+    register_benchmark(quaternion_bench_name<T>("rotate_batch_soa"), 15.0 * RotateBatchSize, RotateBatchSize, [](BenchmarkState& state) {
+        Quaternion<T> q = bench_quaternion<T>(1);
+        VectorBatch<T, 3> in(RotateBatchSize), out(RotateBatchSize);
+        for (int c = 0; c < 3; ++c)
+            bench_fill(in.lane(c), RotateBatchSize, 5 + c);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(q);
+            q.rotate_batch(in, out, false);
+            do_not_optimize(out.lane(0)[0]);
+        }
+    });
+}
+
+static const bool quaternion_benchmarks_registered = [] {
+    register_quaternion_type<float>();
+    register_quaternion_type<double>();
+    return true;
+}();
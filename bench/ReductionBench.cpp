@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <execution>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../Vector.hpp"
+
+// Vector::sum, min, bounding_box and min_magnitude over arrays from L1-resident to far out of cache, against the
+// plain sequential loops and std::reduce / std::transform_reduce with std::execution::par_unseq. Unlike the other
+// batch cases these use the thread pool, as the standard algorithms use theirs; items/s counts vectors.
+// libstdc++ runs them sequentially unless TBB is installed (see Benchmark.hpp).
+
+template <typename T, int N>
+void register_reduction_size(size_t count) {
+    using V = Vector<T, N>;
+    using Span = std::span<const V>;
+    const std::string name = std::string("Reduction<") + bench_type_name<T>() + "," + std::to_string(N) + ">/" + std::to_string(count) + "/";
+    // Filled on first use, so the arrays of filtered-out cases are never allocated
+    auto values = std::make_shared<std::vector<V>>();
+    auto add = [&](const char* op, double flops, auto fn) {
+        register_benchmark(name + op, flops * count, count, [values, count, fn](BenchmarkState& state) {
+            if (values->empty()) {
+                values->resize(count);
+                bench_fill((*values)[0].data.data(), N * count, 1);
+            }
+            for (size_t i = 0; i < state.iterations; ++i) {
+                auto r = fn(Span(*values));
+                do_not_optimize(r);
+            }
+        });
+    };
+
+    add("sum", N, [](Span s) { return V::sum(s); });
+    add("sum_kahan", 4 * N, [](Span s) { return V::template sum<KahanSummation>(s); });
+    add("sum_loop", N, [](Span s) {
+        V total;
+        for (const V& v : s)
+            total += v;
+        return total;
+    });
+    add("sum_reduce_par_unseq", N, [](Span s) { return std::reduce(std::execution::par_unseq, s.begin(), s.end(), V{}); });
+
+    add("min", N, [](Span s) { return V::min(s); });
+    add("min_reduce_par_unseq", N, [](Span s) {
+        return std::reduce(std::execution::par_unseq, s.begin(), s.end(), s[0], [](const V& a, const V& b) {
+            V r;
+            for (int c = 0; c < N; ++c)
+                r.data[c] = std::min(a.data[c], b.data[c]);
+            return r;
+        });
+    });
+
+    add("bounding_box", 2 * N, [](Span s) { return V::bounding_box(s); });
+    add("bounding_box_loop", 2 * N, [](Span s) {
+        typename V::Bounds box{ s[0], s[0] };
+        for (const V& v : s) {
+            for (int c = 0; c < N; ++c) {
+                box.min.data[c] = std::min(box.min.data[c], v.data[c]);
+                box.max.data[c] = std::max(box.max.data[c], v.data[c]);
+            }
+        }
+        return box;
+    });
+    add("bounding_box_reduce_par_unseq", 2 * N, [](Span s) {
+        using Box = typename V::Bounds;
+        return std::transform_reduce(std::execution::par_unseq, s.begin(), s.end(), Box{ s[0], s[0] },
+            [](const Box& a, const Box& b) {
+                Box r;
+                for (int c = 0; c < N; ++c) {
+                    r.min.data[c] = std::min(a.min.data[c], b.min.data[c]);
+                    r.max.data[c] = std::max(a.max.data[c], b.max.data[c]);
+                }
+                return r;
+            },
+            [](const V& v) { return Box{ v, v }; });
+    });
+
+    add("min_magnitude", 2 * N, [](Span s) { return V::min_magnitude(s); });
+    add("min_magnitude_loop", 2 * N, [](Span s) {
+        T best = s[0].magnitude();
+        for (const V& v : s)
+            best = std::min(best, v.magnitude());
+        return best;
+    });
+    add("min_magnitude_reduce_par_unseq", 2 * N, [](Span s) {
+        return std::sqrt(std::transform_reduce(std::execution::par_unseq, s.begin(), s.end(), s[0].dot(s[0]),
+            [](T a, T b) { return std::min(a, b); }, [](const V& v) { return v.dot(v); }));
+    });
+}
+
+template <typename T, int N>
+void register_reduction_type() {
+    for (size_t count : { size_t(1) << 10, size_t(1) << 16, size_t(1) << 22 })
+        register_reduction_size<T, N>(count);
+}
+
+static const bool reduction_benchmarks_registered = [] {
+    register_reduction_type<float, 3>();
+    register_reduction_type<float, 4>();
+    register_reduction_type<double, 3>();
+    return true;
+}();
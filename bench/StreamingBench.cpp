@@ -0,0 +1,95 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../Vector.hpp"
+
+// Vector::normalize_batch and scale_batch over arrays from L1-resident to 512 MiB, four times the last-level cache of
+// the largest current parts, against the plain per-element loops and the streaming kernel forced on at every size.
+// Whether the batch calls stream depends on TINYMATH_STREAMING_MIN_BYTES, so the crossover of the _loop and _stream
+// cases is where it belongs. items/s is memory bandwidth: bytes read plus bytes written per second.
+// Everything runs single-threaded so the numbers measure one core's bandwidth, not the pool.
+
+// One pair of arrays shared by every case, refilled only when the case changes: allocating and filling hundreds of
+// megabytes inside each timed run would swamp the kernels
+struct StreamBenchArrays {
+    std::vector<unsigned char, AlignedAllocator<unsigned char>> in, out;
+    std::string owner;
+};
+
+inline StreamBenchArrays& stream_bench_arrays() {
+    static StreamBenchArrays arrays;
+    return arrays;
+}
+
+template <typename T, int N>
+std::pair<Vector<T, N>*, Vector<T, N>*> stream_bench_prepare(const std::string& owner, size_t count) {
+    using V = Vector<T, N>;
+    StreamBenchArrays& arrays = stream_bench_arrays();
+    if (arrays.owner != owner) {
+        arrays.owner = owner;
+        arrays.in.resize(count * sizeof(V));
+        arrays.out.resize(count * sizeof(V));
+        std::uninitialized_default_construct_n(reinterpret_cast<V*>(arrays.in.data()), count);
+        std::uninitialized_default_construct_n(reinterpret_cast<V*>(arrays.out.data()), count);
+        bench_fill(reinterpret_cast<V*>(arrays.in.data())->data.data(), N * count, 1);
+    }
+    V* in = reinterpret_cast<V*>(arrays.in.data());
+    V* out = reinterpret_cast<V*>(arrays.out.data());
+    return { in, out };
+}
+
+template <typename T, int N>
+void register_streaming_size(size_t bytes) {
+    using V = Vector<T, N>;
+    const size_t count = bytes / sizeof(V);
+    const std::string size = bytes >= (1 << 20) ? std::to_string(bytes >> 20) + "MiB" : std::to_string(bytes >> 10) + "KiB";
+    const std::string name = std::string("Streaming<") + bench_type_name<T>() + "," + std::to_string(N) + ">/" + size + "/";
+    const double traffic = 2.0 * count * sizeof(V);
+    auto add = [&](const char* op, double flops, auto fn) {
+        const std::string full_name = name + op;
+        register_benchmark(full_name, flops * count, traffic, [full_name, count, fn](BenchmarkState& state) {
+            auto [in, out] = stream_bench_prepare<T, N>(full_name, count);
+            for (size_t i = 0; i < state.iterations; ++i) {
+                fn(in, out, count);
+                do_not_optimize(out[count - 1]);
+            }
+        });
+    };
+    const T s = bench_value<T>(3);
+    auto normalize_loop = [](const V* in, V* out, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = in[i].normalized();
+    };
+    auto scale_loop = [s](const V* in, V* out, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = in[i] * s;
+    };
+    // Called on one block at a time the batch functions never stream themselves, so stream_range adds exactly the
+    // prefetching and non-temporal stores
+    auto normalize_batch = [](const V* in, V* out, size_t n) {
+        V::normalize_batch(std::span<const V>(in, n), std::span<V>(out, n), false);
+    };
+    auto scale_batch = [s](const V* in, V* out, size_t n) {
+        V::scale_batch(std::span<const V>(in, n), s, std::span<V>(out, n), false);
+    };
+    add("normalize_loop", 3 * N + 1, normalize_loop);
+    add("normalize_batch", 3 * N + 1, normalize_batch);
+    add("normalize_stream", 3 * N + 1, [normalize_batch](const V* in, V* out, size_t n) { stream_range(in, out, n, true, normalize_batch); });
+    add("scale_loop", N, scale_loop);
+    add("scale_batch", N, scale_batch);
+    add("scale_stream", N, [scale_batch](const V* in, V* out, size_t n) { stream_range(in, out, n, true, scale_batch); });
+}
+
+template <typename T, int N>
+void register_streaming_type() {
+    for (size_t kib : { 16, 256, 4 << 10, 32 << 10, 128 << 10, 512 << 10 })
+        register_streaming_size<T, N>(kib << 10);
+}
+
+static const bool streaming_benchmarks_registered = [] {
+    register_streaming_type<float, 3>();
+    register_streaming_type<float, 4>();
+    register_streaming_type<double, 3>();
+    return true;
+}();
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../DynMatrix.hpp"
+#include "../Matrix.hpp"
+#include "../ThreadPool.hpp"
+
+// Scaling of the multithreaded GEMM: large Matrix::multiply and DynMatrix products on pools of 1, 2, 4, ... threads
+// up to std::thread::hardware_concurrency. Every case routes the library to its own pool with ThreadPool::set_current,
+// so the threads_NN suffix is the total thread count, calling thread included. GFLOP/s divided by the one-thread
+// figure is the speedup.
+
+// Thread counts to time: powers of two below the hardware thread count, then the count itself
+inline std::vector<size_t> bench_thread_counts() {
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < hardware; threads *= 2)
+        counts.push_back(threads);
+    counts.push_back(hardware);
+    return counts;
+}
+
+inline std::string threads_suffix(size_t threads) {
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "/threads_%02zu", threads);
+    return suffix;
+}
+
+// Registers body once per thread count. The pool is created on first use, so filtered-out cases start no threads,
+// and kept across the harness's repeated runs of the case.
+template <typename F>
+void add_threaded_case(const std::string& name, double flops, F body) {
+    for (size_t threads : bench_thread_counts()) {
+        auto pool = std::make_shared<std::unique_ptr<ThreadPool>>();
+        register_benchmark(name + threads_suffix(threads), flops, 1, [threads, pool, body](BenchmarkState& state) {
+            if (!*pool)
+                *pool = std::make_unique<ThreadPool>(threads);
+            ThreadPool::set_current(pool->get());
+            body(state);
+            ThreadPool::set_current(nullptr);
+        });
+    }
+}
+
+// Fixed-size product; the operands are several hundred KiB, so they live on the heap
+template <typename T, int N>
+void register_threaded_matrix_size() {
+    using M = Matrix<T, N, N>;
+    const std::string name = std::string("Threads/Matrix<") + bench_type_name<T>() + "," + std::to_string(N) + "x" + std::to_string(N) + ">/multiply";
+    add_threaded_case(name, 2.0 * N * N * N, [](BenchmarkState& state) {
+        auto a = std::make_unique<M>(), b = std::make_unique<M>(), out = std::make_unique<M>();
+        bench_fill(a->data[0].data(), N * N, 1);
+        bench_fill(b->data[0].data(), N * N, 7);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(*a);
+            *out = *a * *b;
+            do_not_optimize(*out);
+        }
+    });
+}
+
+template <typename T>
+void register_threaded_dyn_size(int n) {
+    const std::string name = std::string("Threads/DynMatrix<") + bench_type_name<T>() + "," + std::to_string(n) + "x" + std::to_string(n) + ">/multiply";
+    add_threaded_case(name, 2.0 * n * n * n, [n](BenchmarkState& state) {
+        DynMatrix<T> a(n, n), b(n, n), out(n, n);
+        bench_fill(a.data(), a.size(), 1);
+        bench_fill(b.data(), b.size(), 7);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(a.data()[0]);
+            multiply_into<T>(a.view(), b.view(), out.view());
+            do_not_optimize(out.data()[0]);
+        }
+    });
+}
+
+template <typename T>
+void register_threaded_type() {
+    register_threaded_matrix_size<T, 256>();
+    for (int n : { 512, 1024, 2048 })
+        register_threaded_dyn_size<T>(n);
+}
+
+static const bool threading_benchmarks_registered = [] {
+    register_threaded_type<float>();
+    register_threaded_type<double>();
+    return true;
+}();
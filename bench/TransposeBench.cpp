@@ -0,0 +1,96 @@
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../DynMatrix.hpp"
+
+// transpose() and transpose_inplace() against the plain double loop they replace, for fixed-size Matrix and for
+// DynMatrix up to sizes that no longer fit in L2. items/s counts elements moved.
+
+// The reference: one row read, one column written per outer iteration
+template <typename T>
+void transpose_double_loop(int rows, int cols, const T* src, T* dst) {
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j)
+            dst[j * rows + i] = src[i * cols + j];
+    }
+}
+
+template <typename T, int N>
+void register_fixed_transpose() {
+    const std::string name = std::string("Transpose<") + bench_type_name<T>() + "," + std::to_string(N) + "x" + std::to_string(N) + ">/";
+    register_benchmark(name + "transpose", 0, N * N, [](BenchmarkState& state) {
+        Matrix<T, N, N> m;
+        bench_fill(m.ptr(), N * N, 1);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(m);
+            auto r = m.transpose();
+            do_not_optimize(r);
+        }
+    });
+    register_benchmark(name + "transpose_loop", 0, N * N, [](BenchmarkState& state) {
+        Matrix<T, N, N> m, r;
+        bench_fill(m.ptr(), N * N, 1);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(m);
+            transpose_double_loop(N, N, m.ptr(), r.ptr());
+            do_not_optimize(r);
+        }
+    });
+    register_benchmark(name + "transpose_inplace", 0, N * N, [](BenchmarkState& state) {
+        Matrix<T, N, N> m;
+        bench_fill(m.ptr(), N * N, 1);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            m.transpose_inplace();
+            do_not_optimize(m);
+        }
+    });
+}
+
+template <typename T>
+void register_dyn_transpose(int rows, int cols) {
+    const std::string name = std::string("Transpose<") + bench_type_name<T>() + "," + std::to_string(rows) + "x" + std::to_string(cols) + ">/dyn_";
+    const double items = static_cast<double>(rows) * cols;
+    register_benchmark(name + "transpose", 0, items, [rows, cols](BenchmarkState& state) {
+        DynMatrix<T> m(rows, cols), r(cols, rows);
+        bench_fill(m.data(), m.size(), 1);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            transpose_blocked(rows, cols, m.data(), cols, r.data(), rows);
+            do_not_optimize(r.data()[0]);
+        }
+    });
+    register_benchmark(name + "transpose_loop", 0, items, [rows, cols](BenchmarkState& state) {
+        DynMatrix<T> m(rows, cols), r(cols, rows);
+        bench_fill(m.data(), m.size(), 1);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            transpose_double_loop(rows, cols, m.data(), r.data());
+            do_not_optimize(r.data()[0]);
+        }
+    });
+    if (rows == cols) {
+        register_benchmark(name + "transpose_inplace", 0, items, [rows, cols](BenchmarkState& state) {
+            DynMatrix<T> m(rows, cols);
+            bench_fill(m.data(), m.size(), 1);
+            for (size_t i = 0; i < state.iterations; ++i) {
+                m.transpose_inplace();
+                do_not_optimize(m.data()[0]);
+            }
+        });
+    }
+}
+
+template <typename T>
+void register_transpose_type() {
+    register_fixed_transpose<T, 4>();
+    register_fixed_transpose<T, 16>();
+    register_fixed_transpose<T, 64>();
+    // The dyn_transpose cases call the blocked kernel directly so the timing excludes allocating the result
+    for (int n : { 64, 256, 1024, 2048 })
+        register_dyn_transpose<T>(n, n);
+    register_dyn_transpose<T>(1000, 3000);
+}
+
+static const bool transpose_benchmarks_registered = [] {
+    register_transpose_type<float>();
+    register_transpose_type<double>();
+    return true;
+}();
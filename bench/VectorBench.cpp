@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "../Vector.hpp"
+
+// Every public Vector operation for float, double and int at sizes 2, 3, 4, 8, 16 and 64, with the precision policies
+// of magnitude, normalized and distance also timed over arrays for throughput. The sizes with a SimdKernel also time
+// the generic loops it replaces, as the _generic cases, and a long chained expression is timed eagerly and with lazy()
+// up to N = 4096.
+// Operands are passed through do_not_optimize each iteration so the compiler cannot fold or hoist the operation.
+
+template <typename T, int N>
+Vector<T, N> bench_vector(size_t seed) {
+    Vector<T, N> v;
+    bench_fill(v.data.data(), N, seed);
+    return v;
+}
+
+template <typename T, int N, typename F>
+void add_vector_case(const char* op, double flops, F fn) {
+    const std::string name = std::string("Vector<") + bench_type_name<T>() + "," + std::to_string(N) + ">/" + op;
+    register_benchmark(name, flops, 1, [fn](BenchmarkState& state) {
+        Vector<T, N> a = bench_vector<T, N>(1);
+        Vector<T, N> b = bench_vector<T, N>(5);
+        T s = bench_value<T>(3);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(a);
+            do_not_optimize(b);
+            do_not_optimize(s);
+            auto r = fn(a, b, s);
+            do_not_optimize(r);
+        }
+    });
+}
+
+// Throughput over ArraySize independent vectors, where the single-vector cases above measure latency
+constexpr size_t ArraySize = 1024;
+
+template <typename T, int N, typename F>
+void add_vector_array_case(const char* op, double flops, F fn) {
+    const std::string name = std::string("Vector<") + bench_type_name<T>() + "," + std::to_string(N) + ">/" + op;
+    register_benchmark(name, flops * ArraySize, ArraySize, [fn](BenchmarkState& state) {
+        std::vector<Vector<T, N>> in(ArraySize);
+        std::vector<decltype(fn(in[0]))> out(ArraySize);
+        bench_fill(in[0].data.data(), N * ArraySize, 1);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            do_not_optimize(in[0]);
+            for (size_t j = 0; j < ArraySize; ++j)
+                out[j] = fn(in[j]);
+            do_not_optimize(out[0]);
+        }
+    });
+}
+
+// The ExactPrecision, FastPrecision and EstimatePrecision paths of magnitude, normalized and distance
+template <typename T, int N>
+void register_vector_precision_cases() {
+    using V = Vector<T, N>;
+    constexpr double n = N;
+    add_vector_case<T, N>("magnitude_fast", 2 * n + 1, [](const V& a, const V&, T) { return a.template magnitude<FastPrecision>(); });
+    add_vector_case<T, N>("magnitude_estimate", 2 * n + 1, [](const V& a, const V&, T) { return a.template magnitude<EstimatePrecision>(); });
+    add_vector_case<T, N>("normalized_fast", 3 * n + 1, [](const V& a, const V&, T) { return a.template normalized<FastPrecision>(); });
+    add_vector_case<T, N>("normalized_estimate", 3 * n + 1, [](const V& a, const V&, T) { return a.template normalized<EstimatePrecision>(); });
+    add_vector_case<T, N>("distance_fast", 3 * n + 1, [](const V& a, const V& b, T) { return V::template distance<FastPrecision>(a, b); });
+    add_vector_case<T, N>("distance_estimate", 3 * n + 1, [](const V& a, const V& b, T) { return V::template distance<EstimatePrecision>(a, b); });
+    add_vector_array_case<T, N>("magnitude_array", 2 * n + 1, [](const V& a) { return a.magnitude(); });
+    add_vector_array_case<T, N>("magnitude_fast_array", 2 * n + 1, [](const V& a) { return a.template magnitude<FastPrecision>(); });
+    add_vector_array_case<T, N>("magnitude_estimate_array", 2 * n + 1, [](const V& a) { return a.template magnitude<EstimatePrecision>(); });
+    add_vector_array_case<T, N>("normalized_array", 3 * n + 1, [](const V& a) { return a.normalized(); });
+    add_vector_array_case<T, N>("normalized_fast_array", 3 * n + 1, [](const V& a) { return a.template normalized<FastPrecision>(); });
+    add_vector_array_case<T, N>("normalized_estimate_array", 3 * n + 1, [](const V& a) { return a.template normalized<EstimatePrecision>(); });
+}
+
+// The generic loops Vector runs for types and sizes without a SimdKernel (and under TINYMATH_NO_SIMD), copied here so
+// the sizes that have one can time both paths in the same build
+template <typename T, int N>
+struct GenericVector {
+    using V = Vector<T, N>;
+
+    template <typename Op>
+    static V apply(const V& a, const V& b, Op op) {
+        V result;
+        std::transform(a.data.begin(), a.data.end(), b.data.begin(), result.data.begin(), op);
+        return result;
+    }
+
+    static V scale(const V& a, T s) {
+        V result;
+        std::transform(a.data.begin(), a.data.end(), result.data.begin(), [&](T x) { return x * s; });
+        return result;
+    }
+
+    static T dot(const V& a, const V& b) { return dot_product<DefaultAccumulation, N>(a.data.data(), b.data.data()); }
+    static T magnitude(const V& a) { return math_sqrt(dot(a, a)); }
+
+    static V normalized(const V& a) {
+        const T mag = magnitude(a);
+        if (!(mag > 0))
+            return a;
+        V result;
+        std::transform(a.data.begin(), a.data.end(), result.data.begin(), [&](T x) { return x / mag; });
+        return result;
+    }
+};
+
+template <typename T, int N>
+void register_vector_generic_cases() {
+    using V = Vector<T, N>;
+    using G = GenericVector<T, N>;
+    constexpr double n = N;
+    add_vector_case<T, N>("add_generic", n, [](const V& a, const V& b, T) { return G::apply(a, b, std::plus<>()); });
+    add_vector_case<T, N>("sub_generic", n, [](const V& a, const V& b, T) { return G::apply(a, b, std::minus<>()); });
+    add_vector_case<T, N>("mul_generic", n, [](const V& a, const V& b, T) { return G::apply(a, b, std::multiplies<>()); });
+    add_vector_case<T, N>("div_generic", n, [](const V& a, const V& b, T) { return G::apply(a, b, std::divides<>()); });
+    add_vector_case<T, N>("mul_scalar_generic", n, [](const V& a, const V&, T s) { return G::scale(a, s); });
+    add_vector_case<T, N>("dot_generic", 2 * n, [](const V& a, const V& b, T) { return G::dot(a, b); });
+    add_vector_case<T, N>("magnitude_generic", 2 * n + 1, [](const V& a, const V&, T) { return G::magnitude(a); });
+    add_vector_case<T, N>("normalized_generic", 3 * n + 1, [](const V& a, const V&, T) { return G::normalized(a); });
+    add_vector_array_case<T, N>("normalized_array_generic", 3 * n + 1, [](const V& a) { return G::normalized(a); });
+}
+
+template <typename T, int N>
+void register_vector_size() {
+    using V = Vector<T, N>;
+    constexpr double n = N;
+
+    // Element-wise and compound assignment
+    add_vector_case<T, N>("add", n, [](const V& a, const V& b, T) { return a + b; });
+    add_vector_case<T, N>("sub", n, [](const V& a, const V& b, T) { return a - b; });
+    add_vector_case<T, N>("mul", n, [](const V& a, const V& b, T) { return a * b; });
+    add_vector_case<T, N>("div", n, [](const V& a, const V& b, T) { return a / b; });
+    add_vector_case<T, N>("add_assign", n, [](V a, const V& b, T) { return a += b; });
+    add_vector_case<T, N>("sub_assign", n, [](V a, const V& b, T) { return a -= b; });
+    add_vector_case<T, N>("mul_assign", n, [](V a, const V& b, T) { return a *= b; });
+    add_vector_case<T, N>("div_assign", n, [](V a, const V& b, T) { return a /= b; });
+
+    // Scalar operations
+    add_vector_case<T, N>("add_scalar", n, [](const V& a, const V&, T s) { return a + s; });
+    add_vector_case<T, N>("sub_scalar", n, [](const V& a, const V&, T s) { return a - s; });
+    add_vector_case<T, N>("mul_scalar", n, [](const V& a, const V&, T s) { return a * s; });
+    add_vector_case<T, N>("div_scalar", n, [](const V& a, const V&, T s) { return a / s; });
+    add_vector_case<T, N>("add_scalar_assign", n, [](V a, const V&, T s) { return a += s; });
+    add_vector_case<T, N>("sub_scalar_assign", n, [](V a, const V&, T s) { return a -= s; });
+    add_vector_case<T, N>("mul_scalar_assign", n, [](V a, const V&, T s) { return a *= s; });
+    add_vector_case<T, N>("div_scalar_assign", n, [](V a, const V&, T s) { return a /= s; });
+
+    // Utilities
+    add_vector_case<T, N>("dot", 2 * n, [](const V& a, const V& b, T) { return a.dot(b); });
+    add_vector_case<T, N>("dot_exact", 2 * n, [](const V& a, const V& b, T) { return a.template dot<ExactAccumulation>(b); });
+    add_vector_case<T, N>("magnitude", 2 * n + 1, [](const V& a, const V&, T) { return a.magnitude(); });
+    add_vector_case<T, N>("normalized", 3 * n + 1, [](const V& a, const V&, T) { return a.normalized(); });
+    add_vector_case<T, N>("normalize", 3 * n + 1, [](V a, const V&, T) { return a.normalize(); });
+    add_vector_case<T, N>("distance", 3 * n + 1, [](const V& a, const V& b, T) { return V::distance(a, b); });
+    if constexpr (std::is_floating_point_v<T>)
+        register_vector_precision_cases<T, N>();
+    if constexpr (SimdKernel<T, N>::enabled)
+        register_vector_generic_cases<T, N>();
+    if constexpr (N == 3)
+        add_vector_case<T, N>("cross", 9, [](const V& a, const V& b, T) { return a.cross(b); });
+    add_vector_case<T, N>("clamp", 0, [](const V& a, const V&, T s) { return a.clamp(s, s + s); });
+    add_vector_case<T, N>("lerp", 3 * n, [](const V& a, const V& b, T s) { return V::lerp(a, b, s); });
+    add_vector_case<T, N>("reflect", 4 * n + 1, [](const V& a, const V& b, T) { return a.reflect(b); });
+    add_vector_case<T, N>("lazy_axpy", 2 * n, [](const V& a, const V& b, T s) { return V(lazy(a) * s + lazy(b)); });
+
+    // Operators
+    add_vector_case<T, N>("equal", 0, [](const V& a, const V& b, T) { return a == b; });
+    add_vector_case<T, N>("not_equal", 0, [](const V& a, const V& b, T) { return a != b; });
+    add_vector_case<T, N>("negate", n, [](const V& a, const V&, T) { return -a; });
+    add_vector_case<T, N>("subscript", 0, [](const V& a, const V&, T) { return a[N - 1]; });
+}
+
+// a * s + b - c * t + d: four temporaries and four stores per element evaluated eagerly, one pass with lazy()
+template <typename T, int N>
+void register_vector_chain_size() {
+    using V = Vector<T, N>;
+    const std::string name = std::string("Vector<") + bench_type_name<T>() + "," + std::to_string(N) + ">/";
+    auto add = [&](const char* op, auto fn) {
+        register_benchmark(name + op, 6.0 * N, 1, [fn](BenchmarkState& state) {
+            V a = bench_vector<T, N>(1), b = bench_vector<T, N>(5), c = bench_vector<T, N>(9), d = bench_vector<T, N>(13);
+            T s = bench_value<T>(3), t = bench_value<T>(4);
+            for (size_t i = 0; i < state.iterations; ++i) {
+                do_not_optimize(a);
+                do_not_optimize(s);
+                V r = fn(a, b, c, d, s, t);
+                do_not_optimize(r);
+            }
+        });
+    };
+    add("chain", [](const V& a, const V& b, const V& c, const V& d, T s, T t) { return a * s + b - c * t + d; });
+    add("lazy_chain", [](const V& a, const V& b, const V& c, const V& d, T s, T t) {
+        return V(lazy(a) * s + lazy(b) - lazy(c) * t + lazy(d));
+    });
+}
+
+template <typename T>
+void register_vector_type() {
+    register_vector_size<T, 2>();
+    register_vector_size<T, 3>();
+    register_vector_size<T, 4>();
+    register_vector_size<T, 8>();
+    register_vector_size<T, 16>();
+    register_vector_size<T, 64>();
+    register_vector_chain_size<T, 64>();
+    register_vector_chain_size<T, 1024>();
+    register_vector_chain_size<T, 4096>();
+}
+
+static const bool vector_benchmarks_registered = [] {
+    register_vector_type<float>();
+    register_vector_type<double>();
+    register_vector_type<int>();
+    return true;
+}();
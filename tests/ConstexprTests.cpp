@@ -0,0 +1,119 @@
+#include "../MathAPI.hpp"
+
+// Compile-time checks of the constexpr Vector and Matrix API: every check is a static_assert, so the file passing
+// is the file compiling. Expected values are exact, or rounded the same way as the computation, so the comparisons
+// use ==.
+//
+// Build (standard library only):
+//   g++ -std=c++20 -I. -fsyntax-only tests/ConstexprTests.cpp
+
+// --- math_sqrt ---
+
+static_assert(math_sqrt(0.25) == 0.5);
+static_assert(math_sqrt(2.0) == 1.4142135623730951);
+static_assert(math_sqrt(2.0f) == 1.41421354f);
+static_assert(math_sqrt(1e300) == 1e150);
+static_assert(math_sqrt(0.0) == 0.0);
+static_assert(math_sqrt(-1.0) != math_sqrt(-1.0));   // NaN
+static_assert(math_sqrt(16) == 4.0);
+static_assert(math_abs(-3) == 3 && math_abs(2.5f) == 2.5f);
+
+// --- Vector ---
+
+constexpr Vector<float, 3> a{ 1, 2, 3 };
+constexpr Vector<float, 3> b{ 4, 5, 6 };
+
+static_assert(a + b == Vector<float, 3>{ 5, 7, 9 });
+static_assert(b - a == Vector<float, 3>{ 3, 3, 3 });
+static_assert(a * b == Vector<float, 3>{ 4, 10, 18 });
+static_assert(b / a == Vector<float, 3>{ 4, 2.5f, 2 });
+static_assert(a + 1.0f == Vector<float, 3>{ 2, 3, 4 });
+static_assert(a * 2.0f == Vector<float, 3>{ 2, 4, 6 });
+static_assert(b / 2.0f == Vector<float, 3>{ 2, 2.5f, 3 });
+static_assert(-a == Vector<float, 3>{ -1, -2, -3 });
+static_assert(a != b && a[2] == 3);
+
+static_assert(a.dot(b) == 32);
+static_assert(a.dot<ExactAccumulation>(b) == 32);
+static_assert(a.cross(b) == Vector<float, 3>{ -3, 6, -3 });
+static_assert(a.clamp(1.5f, 2.5f) == Vector<float, 3>{ 1.5f, 2, 2.5f });
+static_assert(Vector<float, 3>::lerp(a, b, 0.5f) == Vector<float, 3>{ 2.5f, 3.5f, 4.5f });
+static_assert(Vector<float, 3>{ 1, -1, 0 }.reflect({ 0, 1, 0 }) == Vector<float, 3>{ 1, 1, 0 });
+static_assert(Vector<float, 3>::distance_squared(a, b) == 27);
+
+static_assert(Vector<double, 3>{ 3, 4, 0 }.magnitude() == 5.0);
+static_assert(Vector<double, 3>{ 3, 4, 0 }.normalized() == Vector<double, 3>{ 0.6, 0.8, 0 });
+static_assert(Vector<double, 3>{ 0, 0, 0 }.normalized() == Vector<double, 3>{ 0, 0, 0 });
+static_assert(Vector<float, 4>{ 1, 1, 1, 1 }.normalized()[0] == 0.5f);
+static_assert(Vector<int, 2>{ 3, 4 }.magnitude() == 5);
+static_assert(Vector<double, 2>::distance(Vector<double, 2>{ 1, 1 }, Vector<double, 2>{ 4, 5 }) == 5.0);
+
+// The reciprocal square root paths are run-time only; constant evaluation takes the exact path
+static_assert(Vector<double, 3>{ 3, 4, 0 }.magnitude<FastPrecision>() == 5.0);
+static_assert(Vector<float, 4>{ 0, 0, 3, 4 }.normalized<EstimatePrecision>() == Vector<float, 4>{ 0, 0, 0.6f, 0.8f });
+
+constexpr Vector<double, 4> compound = [] {
+    Vector<double, 4> v{ 0, 0, 3, 4 };
+    v.normalize();
+    v += Vector<double, 4>{ 1, 1, 1, 1 };
+    v *= 2.0;
+    v -= 1.0;
+    return v;
+}();
+static_assert(compound == Vector<double, 4>{ 1, 1, 2.2, 2.6 });
+
+// Lazy expressions evaluate in a single loop at compile time as well
+constexpr Vector<float, 3> fused = lazy(a) + lazy(b) * 2.0f - lazy(a);
+static_assert(fused == Vector<float, 3>{ 8, 10, 12 });
+
+// --- Matrix ---
+
+constexpr Matrix<float, 3, 3> rotate_z{ { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } };
+constexpr Matrix<float, 3, 3> identity3{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+static_assert(rotate_z * rotate_z * rotate_z * rotate_z == identity3);
+static_assert((rotate_z + rotate_z - rotate_z) == rotate_z);
+static_assert((rotate_z * 2.0f)[1][0] == 2 && (rotate_z / 2.0f)[0][1] == -0.5f);
+static_assert(rotate_z.transpose()[0][1] == 1);
+static_assert(rotate_z.transform(Vector<float, 3>{ 1, 0, 0 }) == Vector<float, 3>{ 0, 1, 0 });
+static_assert(rotate_z * Vector<float, 3>{ 1, 0, 0 } == Vector<float, 3>{ 0, 1, 0 });
+static_assert(rotate_z.transpose_multiply(Vector<float, 3>{ 0, 1, 0 }) == Vector<float, 3>{ 1, 0, 0 });
+static_assert(rotate_z(0, 1) == -1);
+
+// Rectangular products and transforms
+constexpr Matrix<int, 2, 3> wide{ { 1, 2, 3 }, { 4, 5, 6 } };
+static_assert(wide * wide.transpose() == Matrix<int, 2, 2>{ { 14, 32 }, { 32, 77 } });
+static_assert(wide * Vector<int, 3>{ 1, 1, 1 } == Vector<int, 2>{ 6, 15 });
+static_assert(wide.transpose_multiply(Vector<int, 2>{ 1, 1 }) == Vector<int, 3>{ 5, 7, 9 });
+
+// Sizes that take the blocked GEMM and transpose at run time use the plain loops at compile time
+constexpr Matrix<double, 24, 24> scaled_identity = [] {
+    Matrix<double, 24, 24> m;
+    for (int i = 0; i < 24; i++)
+        m[i][i] = 2;
+    m(0, 23) = 1;
+    return m * m;
+}();
+static_assert(scaled_identity[5][5] == 4 && scaled_identity[0][23] == 4 && scaled_identity.transpose()[23][0] == 4);
+
+// Column-major storage gives the same results
+constexpr Matrix<float, 3, 3, ColumnMajor> rotate_z_column(rotate_z);
+static_assert(rotate_z_column(0, 1) == -1 && rotate_z_column.data[1][0] == -1);
+static_assert(rotate_z_column.transform(Vector<float, 3>{ 1, 0, 0 }) == Vector<float, 3>{ 0, 1, 0 });
+static_assert(Matrix<float, 3, 3>(rotate_z_column * rotate_z_column) == rotate_z * rotate_z);
+
+// Determinant and the closed-form inverses
+constexpr Matrix<double, 2, 2> m2{ { 4, 6 }, { 2, 4 } };
+static_assert(m2.determinant() == 4);
+static_assert(m2.inverse() == Matrix<double, 2, 2>{ { 1, -1.5 }, { -0.5, 1 } });
+static_assert(m2 * m2.inverse() == Matrix<double, 2, 2>{ { 1, 0 }, { 0, 1 } });
+static_assert(rotate_z.determinant() == 1 && rotate_z.inverse() == rotate_z.transpose());
+
+constexpr Matrix<float, 4, 4> translate{ { 1, 0, 0, 5 }, { 0, 1, 0, -2 }, { 0, 0, 1, 3 }, { 0, 0, 0, 1 } };
+static_assert(translate.affine_inverse()(0, 3) == -5 && translate.rigid_inverse()(1, 3) == 2);
+static_assert(translate.determinant() == 1);
+
+constexpr Matrix<float, 2, 2> doubled = lazy(Matrix<float, 2, 2>{ { 1, 2 }, { 3, 4 } }) * 2.0f;
+static_assert(doubled[1][1] == 8);
+
+int main() { return 0; }
@@ -0,0 +1,74 @@
+#define TINYMATH_INSTRUMENT
+#include <cstdio>
+#include <vector>
+#include "../MathAPI.hpp"
+
+// Run-time checks that instrumentation records only the outermost call, whether a batch runs on one thread or is
+// split across a four-thread pool: the counts must not depend on the thread count. Prints every failed check; exits
+// non-zero if any.
+//
+// Build and run (standard library only):
+//   g++ -std=c++20 -I. tests/InstrumentationTests.cpp -o instrumentation_tests -pthread && ./instrumentation_tests
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("FAILED: %s\n", what);
+        ++failures;
+    }
+}
+
+// Large enough that parallel_for splits it into several chunks
+constexpr size_t BatchSize = 3 * TINYMATH_PARALLEL_MIN_BATCH + 17;
+
+// Calls per operation of one scale_batch, normalize_batch and transform_batch on a five-component vector, which has
+// no SIMD batch kernel, so every element goes through the instrumented Vector operations
+static InstrumentationSnapshot batch_counts(bool allow_threads) {
+    using V = Vector<double, 5>;
+    std::vector<V> in(BatchSize, V{ 1, 2, 3, 4, 5 }), out(BatchSize);
+    Matrix<double, 5, 5> m;
+    for (int i = 0; i < 5; ++i)
+        m[i][i] = 1;
+
+    reset_instrumentation();
+    V::scale_batch(in, 2.0, out, allow_threads);
+    V::normalize_batch(in, out, allow_threads);
+    m.transform_batch(std::span<const V>(in), std::span<V>(out), allow_threads);
+    (void)V::sum(in, allow_threads);
+    return instrumentation_snapshot();
+}
+
+static void check_outermost(const InstrumentationSnapshot& counts, const char* label) {
+    char what[128];
+    const auto expect = [&](InstrumentedOp op, uint64_t calls) {
+        std::snprintf(what, sizeof(what), "%s: %s calls", label, instrumented_op_name(op));
+        check(counts[op].calls == calls, what);
+    };
+    expect(InstrumentedOp::VectorScaleBatch, 1);
+    expect(InstrumentedOp::VectorNormalizeBatch, 1);
+    expect(InstrumentedOp::MatrixTransformBatch, 1);
+    expect(InstrumentedOp::VectorReduction, 1);
+    expect(InstrumentedOp::VectorElementwise, 0);
+    expect(InstrumentedOp::VectorNormalize, 0);
+    expect(InstrumentedOp::VectorMagnitude, 0);
+    expect(InstrumentedOp::MatrixTransform, 0);
+}
+
+int main() {
+    check_outermost(batch_counts(false), "serial");
+
+    ThreadPool pool(4);
+    ThreadPool::set_current(&pool);
+    check_outermost(batch_counts(true), "four threads");
+
+    // A job submitted outside any instrumented call records its calls on every thread that runs them
+    reset_instrumentation();
+    pool.run(8, [](size_t i) { (void)(Vector<double, 5>{ 1, 2, 3, 4, 5 } * double(i)); });
+    check(instrumentation_snapshot()[InstrumentedOp::VectorElementwise].calls == 8, "top-level job: vector_elementwise calls");
+    ThreadPool::set_current(nullptr);
+
+    if (failures == 0)
+        std::printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <vector>
+#include "../MathAPI.hpp"
+
+// Run-time checks of the batched transforms called in place (out == in), on the array-of-structures and the
+// VectorBatch paths, serially and split across a four-thread pool. Prints every failed check; exits non-zero if any.
+//
+// Build and run (standard library only):
+//   g++ -std=c++20 -I. tests/TransformBatchTests.cpp -o transform_batch_tests -pthread && ./transform_batch_tests
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("FAILED: %s\n", what);
+        ++failures;
+    }
+}
+
+// Large enough that parallel_for splits it into several chunks
+constexpr size_t BatchSize = 3 * TINYMATH_PARALLEL_MIN_BATCH + 17;
+
+template <typename T>
+Vector<T, 3> test_vector(size_t i) {
+    return Vector<T, 3>{ static_cast<T>(i % 7), static_cast<T>(i % 5 + 10), static_cast<T>(i % 3 + 20) };
+}
+
+// A cyclic permutation: every output lane is another input lane, so a row written early is read again by a later row
+template <typename T, typename Layout>
+void check_permutation(bool allow_threads) {
+    const Matrix<T, 3, 3, Layout> cycle(Matrix<T, 3, 3>{ { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } });
+
+    VectorBatch<T, 3> lanes(BatchSize);
+    std::vector<Vector<T, 3>> packed(BatchSize);
+    for (size_t i = 0; i < BatchSize; ++i) {
+        lanes.set(i, test_vector<T>(i));
+        packed[i] = test_vector<T>(i);
+    }
+    cycle.transform_batch(lanes, lanes, allow_threads);
+    cycle.transform_batch(std::span<const Vector<T, 3>>(packed), std::span<Vector<T, 3>>(packed), allow_threads);
+
+    bool lanes_ok = true, packed_ok = true;
+    for (size_t i = 0; i < BatchSize; ++i) {
+        const Vector<T, 3> v = test_vector<T>(i);
+        const Vector<T, 3> expected{ v[1], v[2], v[0] };
+        lanes_ok = lanes_ok && lanes.get(i) == expected;
+        packed_ok = packed_ok && packed[i] == expected;
+    }
+    check(lanes_ok, "Matrix::transform_batch(VectorBatch) in place");
+    check(packed_ok, "Matrix::transform_batch(span) in place");
+}
+
+template <typename T>
+void check_rotation(bool allow_threads) {
+    const Quaternion<T> q = Quaternion<T>::from_axis_angle(Vector<T, 3>{ 1, 2, 3 }.normalized(), T(0.7));
+    VectorBatch<T, 3> lanes(BatchSize);
+    VectorBatch<T, 3> separate(BatchSize);
+    for (size_t i = 0; i < BatchSize; ++i)
+        lanes.set(i, test_vector<T>(i));
+    q.rotate_batch(lanes, separate, allow_threads);
+    q.rotate_batch(lanes, lanes, allow_threads);
+
+    bool ok = true;
+    for (size_t i = 0; i < BatchSize; ++i)
+        ok = ok && lanes.get(i) == separate.get(i);
+    check(ok, "Quaternion::rotate_batch(VectorBatch) in place");
+}
+
+template <typename T>
+void check_type(bool allow_threads) {
+    check_permutation<T, RowMajor>(allow_threads);
+    check_permutation<T, ColumnMajor>(allow_threads);
+    check_rotation<T>(allow_threads);
+}
+
+int main() {
+    check_type<float>(false);
+    check_type<double>(false);
+
+    ThreadPool pool(4);
+    ThreadPool::set_current(&pool);
+    check_type<float>(true);
+    check_type<double>(true);
+    ThreadPool::set_current(nullptr);
+
+    if (failures == 0)
+        std::printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}